@@ -0,0 +1,100 @@
+/* Read-side cost of the Epoch memory reclamation: readers wrap every read of a shared item in ep_enter/ep_exit,
+   without any writer, and while a writer keeps replacing the item and retiring the previous one */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "../lib/ADT.h"
+
+// reads of every reader thread, and largest number of reader threads
+#define READS 4000000
+#define MAX_READERS 4
+
+// state shared by the threads of a run
+typedef struct shared{
+    EpochDomain ed;
+    _Atomic(long *) current; // the item the readers read
+    atomic_int reading; // number of readers still running
+    atomic_long retires; // number of items retired by the writer
+}shared;
+
+// returns the current time in seconds
+double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// DestroyFunc of the items
+void destroy_item(Pointer a)
+{
+    free(a);
+}
+
+// reads the current item READS times, each in a critical section
+void *reader(void *arg)
+{
+    shared *sh = arg;
+    long sum = 0;
+    for (int i = 0; i < READS; i++){
+        ep_enter(sh->ed);
+        sum += *atomic_load_explicit(&sh->current, memory_order_acquire);
+        ep_exit(sh->ed);
+    }
+    atomic_fetch_sub(&sh->reading, 1);
+    return (void *)sum;
+}
+
+// replaces the current item with a new one and retires the previous one, until the readers are done
+void *writer(void *arg)
+{
+    shared *sh = arg;
+    long retires = 0;
+    while (atomic_load(&sh->reading)){
+        long *item = malloc(sizeof(long));
+        *item = retires;
+        ep_retire(atomic_exchange(&sh->current, item), destroy_item, sh->ed);
+        retires++;
+    }
+    atomic_store(&sh->retires, retires);
+    return NULL;
+}
+
+// runs given number of readers, with or without a writer, and prints the time per read
+void run(int readers, bool retiring)
+{
+    shared sh;
+    ep_initialize(&sh.ed);
+    long *item = malloc(sizeof(long));
+    *item = 0;
+    atomic_init(&sh.current, item);
+    atomic_init(&sh.reading, readers);
+    atomic_init(&sh.retires, 0);
+    pthread_t threads[MAX_READERS + 1];
+    double start = now();
+    for (int i = 0; i < readers; i++) pthread_create(&threads[i], NULL, reader, &sh);
+    if (retiring) pthread_create(&threads[readers], NULL, writer, &sh);
+    for (int i = 0; i < readers + retiring; i++) pthread_join(threads[i], NULL);
+    double elapsed = now() - start;
+    printf("%d reader(s), %-16s: %6.1f ns per read, %8.1f M reads/s", readers, retiring ? "with retires" : "without retires",
+           elapsed * 1e9 / (readers * (double)READS), readers * (double)READS / elapsed / 1e6);
+    if (retiring) printf(", %ld retires", atomic_load(&sh.retires));
+    printf("\n");
+    ep_destroy(sh.ed);
+    free(atomic_load(&sh.current));
+}
+
+int main(void)
+{
+    printf("ep_enter/ep_exit around a read, %d reads per reader, %ld CPU(s) online\n", READS, sysconf(_SC_NPROCESSORS_ONLN));
+    for (int readers = 1; readers <= MAX_READERS; readers *= 2){
+        run(readers, false);
+        run(readers, true);
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+/* Scaling of the parallel operations of the Red-Black Tree with the number of threads of the Thread Pool */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "../lib/ADT.h"
+
+// number of items of the batches and of the trees, and largest number of threads
+#define ITEMS 2000000
+#define MAX_THREADS 8
+
+// CompareFunc of the trees
+int compare_ints(Pointer a, Pointer b)
+{
+    return *(int *)a - *(int *)b;
+}
+
+// returns the current time in seconds
+double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// returns the seconds taken by red_black_insert_many_parallel for the items, on an empty tree
+double time_insert_many(Pointer *items, ThreadPool tp)
+{
+    RedBlackTree rbt;
+    red_black_initialize(&rbt, compare_ints, NULL, NULL);
+    double start = now();
+    red_black_insert_many_parallel(items, ITEMS, rbt, tp);
+    double elapsed = now() - start;
+    red_black_destroy(rbt);
+    return elapsed;
+}
+
+// returns the seconds taken by red_black_union_parallel for trees of the first and the second half of the items
+double time_union(Pointer *items, ThreadPool tp)
+{
+    RedBlackTree a, b;
+    red_black_initialize(&a, compare_ints, NULL, NULL);
+    red_black_initialize(&b, compare_ints, NULL, NULL);
+    red_black_insert_many_parallel(items, ITEMS / 2, a, tp);
+    red_black_insert_many_parallel(items + ITEMS / 2, ITEMS / 2, b, tp);
+    double start = now();
+    red_black_union_parallel(a, b, tp);
+    double elapsed = now() - start;
+    red_black_destroy(a);
+    return elapsed;
+}
+
+int main(void)
+{
+    printf("parallel Red-Black Tree operations on %d random items, %ld CPU(s) online\n", ITEMS, sysconf(_SC_NPROCESSORS_ONLN));
+    int *keys = malloc(ITEMS * sizeof(int));
+    Pointer *items = malloc(ITEMS * sizeof(Pointer));
+    if (keys == NULL || items == NULL) return 1;
+    srand(1);
+    for (int i = 0; i < ITEMS; i++){
+        keys[i] = rand();
+        items[i] = &keys[i];
+    }
+    double insert_base = time_insert_many(items, NULL), union_base = time_union(items, NULL);
+    printf("sequential  : insert_many %7.3f s, union %7.3f s\n", insert_base, union_base);
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2){
+        ThreadPool tp;
+        tp_initialize(&tp, threads);
+        double insert_time = time_insert_many(items, tp), union_time = time_union(items, tp);
+        printf("%d thread(s) : insert_many %7.3f s (x%.2f), union %7.3f s (x%.2f)\n", threads,
+               insert_time, insert_base / insert_time, union_time, union_base / union_time);
+        tp_destroy(tp);
+    }
+    free(keys);
+    free(items);
+    return 0;
+}
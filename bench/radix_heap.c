@@ -0,0 +1,142 @@
+/* Dijkstra's algorithm on a random graph with a Radix Heap and with a Priority Queue */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../lib/ADT.h"
+
+// size of the graph, and range of the edge weights
+#define VERTICES 200000
+#define EDGES_PER_VERTEX 8
+#define MAX_WEIGHT 1000
+
+// edge of the graph
+typedef struct edge{
+    int to;
+    unsigned long weight;
+}edge;
+
+// entry of the heaps: a vertex and its tentative distance (stale once the vertex is settled with a smaller one)
+typedef struct entry{
+    int vertex;
+    unsigned long distance;
+}entry;
+
+// the graph, in adjacency arrays (the edges of vertex v are edges[v * EDGES_PER_VERTEX ...])
+static edge edges[VERTICES * EDGES_PER_VERTEX];
+
+// entries of a run, allocated in order (every relaxation pushes one)
+static entry entries[VERTICES * EDGES_PER_VERTEX + 1];
+static size_t used;
+
+// KeyFunc of the radix heap
+unsigned long entry_key(Pointer a)
+{
+    return ((entry *)a)->distance;
+}
+
+// CompareFunc of the priority queue (which removes the smallest item first)
+int compare_entries(Pointer a, Pointer b)
+{
+    unsigned long da = ((entry *)a)->distance, db = ((entry *)b)->distance;
+    return da < db ? -1 : da > db ? 1 : 0;
+}
+
+// returns a new entry for given vertex and distance
+entry *new_entry(int vertex, unsigned long distance)
+{
+    entry *e = &entries[used++];
+    e->vertex = vertex;
+    e->distance = distance;
+    return e;
+}
+
+// returns the current time in seconds
+double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// runs Dijkstra from vertex 0 with the radix heap, filling distance; returns the sum of the distances
+unsigned long dijkstra_radix(unsigned long *distance)
+{
+    RadixHeap rh;
+    rh_initialize(&rh, entry_key, NULL, NULL);
+    used = 0;
+    for (int v = 0; v < VERTICES; v++) distance[v] = (unsigned long)-1;
+    distance[0] = 0;
+    rh_insert(new_entry(0, 0), rh);
+    entry *e;
+    while ((e = rh_remove(rh)) != NULL){
+        if (e->distance != distance[e->vertex]) continue;
+        for (edge *ed = &edges[e->vertex * EDGES_PER_VERTEX]; ed < &edges[(e->vertex + 1) * EDGES_PER_VERTEX]; ed++){
+            unsigned long d = e->distance + ed->weight;
+            if (d < distance[ed->to]){
+                distance[ed->to] = d;
+                rh_insert(new_entry(ed->to, d), rh);
+            }
+        }
+    }
+    rh_destroy(rh);
+    unsigned long sum = 0;
+    for (int v = 0; v < VERTICES; v++) if (distance[v] != (unsigned long)-1) sum += distance[v];
+    return sum;
+}
+
+// runs Dijkstra from vertex 0 with the priority queue, filling distance; returns the sum of the distances
+unsigned long dijkstra_pq(unsigned long *distance)
+{
+    PriorityQueue pq;
+    pq_initialize(&pq, compare_entries, NULL, NULL);
+    used = 0;
+    for (int v = 0; v < VERTICES; v++) distance[v] = (unsigned long)-1;
+    distance[0] = 0;
+    pq_insert(new_entry(0, 0), pq);
+    entry *e;
+    while ((e = pq_remove(pq)) != NULL){
+        if (e->distance != distance[e->vertex]) continue;
+        for (edge *ed = &edges[e->vertex * EDGES_PER_VERTEX]; ed < &edges[(e->vertex + 1) * EDGES_PER_VERTEX]; ed++){
+            unsigned long d = e->distance + ed->weight;
+            if (d < distance[ed->to]){
+                distance[ed->to] = d;
+                pq_insert(new_entry(ed->to, d), pq);
+            }
+        }
+    }
+    pq_destroy(pq);
+    unsigned long sum = 0;
+    for (int v = 0; v < VERTICES; v++) if (distance[v] != (unsigned long)-1) sum += distance[v];
+    return sum;
+}
+
+int main(void)
+{
+    srand(1);
+    for (int i = 0; i < VERTICES * EDGES_PER_VERTEX; i++){
+        edges[i].to = rand() % VERTICES;
+        edges[i].weight = 1 + rand() % MAX_WEIGHT;
+    }
+    unsigned long *distance = malloc(VERTICES * sizeof(unsigned long));
+    if (distance == NULL) return 1;
+
+    double start = now();
+    unsigned long radix_sum = dijkstra_radix(distance);
+    double radix_time = now() - start;
+    size_t radix_pushes = used;
+
+    start = now();
+    unsigned long pq_sum = dijkstra_pq(distance);
+    double pq_time = now() - start;
+
+    printf("Dijkstra, %d vertices, %d edges, weights 1-%d (%zu heap inserts)\n", VERTICES, VERTICES * EDGES_PER_VERTEX, MAX_WEIGHT, radix_pushes);
+    printf("Radix Heap     : %8.3f s\n", radix_time);
+    printf("Priority Queue : %8.3f s\n", pq_time);
+    free(distance);
+    if (radix_sum != pq_sum){
+        printf("the distances differ\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+/* Throughput of the lock-free Skip List and of a Red-Black Tree behind a mutex, with many threads
+   running a mix of searches, inserts and removes on the same container */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "../lib/ADT.h"
+
+// range of the keys (half of them are in the container at the start), and operations of every thread
+#define KEYS 1000000
+#define OPERATIONS 1000000
+#define MAX_THREADS 4
+
+// percentage of searches; the rest of the operations are inserts and removes, half each
+#define SEARCH_PERCENT 80
+
+// the items; the containers point to them, so they are never destroyed
+static int values[KEYS];
+
+// CompareFunc of the containers
+int compare_ints(Pointer a, Pointer b)
+{
+    return *(int *)a - *(int *)b;
+}
+
+// returns the current time in seconds
+double now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// returns the next number of given xorshift64 generator
+uint64_t next_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// the red black tree and its lock
+typedef struct locked_tree{
+    pthread_mutex_t lock;
+    RedBlackTree rbt;
+}locked_tree;
+
+// arguments of a thread
+typedef struct worker{
+    void *container; // the skip list or the locked tree
+    uint64_t seed;
+}worker;
+
+// runs the operations on the skip list
+void *skip_list_worker(void *arg)
+{
+    worker *w = arg;
+    SkipList sl = w->container;
+    for (int i = 0; i < OPERATIONS; i++){
+        uint64_t r = next_random(&w->seed);
+        int *key = &values[(r >> 8) % KEYS];
+        int operation = r % 100;
+        if (operation < SEARCH_PERCENT) sl_search(key, sl);
+        else if (operation % 2) sl_insert(key, sl);
+        else sl_remove(key, sl);
+    }
+    return NULL;
+}
+
+// runs the operations on the red black tree, locking it for each one
+void *locked_tree_worker(void *arg)
+{
+    worker *w = arg;
+    locked_tree *lt = w->container;
+    for (int i = 0; i < OPERATIONS; i++){
+        uint64_t r = next_random(&w->seed);
+        int *key = &values[(r >> 8) % KEYS];
+        int operation = r % 100;
+        pthread_mutex_lock(&lt->lock);
+        if (operation < SEARCH_PERCENT) red_black_search(key, lt->rbt);
+        else if (operation % 2) red_black_insert(key, lt->rbt);
+        else red_black_remove(key, lt->rbt);
+        pthread_mutex_unlock(&lt->lock);
+    }
+    return NULL;
+}
+
+// runs given number of threads on the container, and returns the throughput in millions of operations per second
+double run(int threads, void *(*work)(void *), void *container)
+{
+    pthread_t ids[MAX_THREADS];
+    worker workers[MAX_THREADS];
+    double start = now();
+    for (int i = 0; i < threads; i++){
+        workers[i].container = container;
+        workers[i].seed = 0x9E3779B97F4A7C15ULL * (i + 1);
+        pthread_create(&ids[i], NULL, work, &workers[i]);
+    }
+    for (int i = 0; i < threads; i++) pthread_join(ids[i], NULL);
+    return threads * (double)OPERATIONS / (now() - start) / 1e6;
+}
+
+int main(void)
+{
+    printf("%d%% searches, %d%% inserts, %d%% removes on %d keys, %d operations per thread, %ld CPU(s) online\n",
+           SEARCH_PERCENT, (100 - SEARCH_PERCENT) / 2, (100 - SEARCH_PERCENT) / 2, KEYS, OPERATIONS, sysconf(_SC_NPROCESSORS_ONLN));
+    for (int i = 0; i < KEYS; i++) values[i] = i;
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2){
+        SkipList sl;
+        sl_initialize(&sl, compare_ints, NULL, NULL);
+        locked_tree lt;
+        pthread_mutex_init(&lt.lock, NULL);
+        red_black_initialize(&lt.rbt, compare_ints, NULL, NULL);
+        for (int i = 0; i < KEYS; i += 2){
+            sl_insert(&values[i], sl);
+            red_black_insert(&values[i], lt.rbt);
+        }
+        double skip_list = run(threads, skip_list_worker, sl);
+        double tree = run(threads, locked_tree_worker, &lt);
+        printf("%d thread(s): Skip List %6.2f M ops/s, locked Red-Black Tree %6.2f M ops/s\n", threads, skip_list, tree);
+        sl_destroy(sl);
+        red_black_destroy(lt.rbt);
+        pthread_mutex_destroy(&lt.lock);
+    }
+    return 0;
+}
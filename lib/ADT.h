@@ -3,7 +3,16 @@
 #ifndef ADT_LIB_H
 #define ADT_LIB_H
 
+#include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>
+
+// operation counters of a container (AdtStats), returned by the *_get_stats functions
+// they are only maintained if the library is compiled with `make lib STATS=1`; else they are always zero
+#include "../modules/Stats/Stats.h"
+
+// iterators of the modules (StackIterator, RBTIterator etc.), declared by the user (usually as local variables)
+#include "../modules/Iterators/Iterators.h"
 
 // Generic typedefs used in all modules
 
@@ -16,22 +25,85 @@ typedef void *Pointer;
    > 0 if a > b                                                   */
 typedef int (*CompareFunc)(Pointer a, Pointer b);
 
+// pointer to function that returns the (unsigned integer) key of given element, used by the radix heap
+// elements with smaller keys have higher priority
+typedef unsigned long (*KeyFunc)(Pointer);
+
+// pointer to function that returns the shard of given element (a hash of it, or the number of its key range),
+// taken modulo the number of shards of a sharded map; equal elements must have the same shard
+typedef size_t (*ShardFunc)(Pointer);
+
 // pointer to function that destroys given element
 typedef void (*DestroyFunc)(Pointer);
 
+// pointer to function that encodes given element into a fixed-size key and a fixed-size value, used by index files
+// (key and value point to key_size and value_size zeroed bytes respectively)
+typedef void (*EncodeFunc)(Pointer item, Pointer key, Pointer value);
+
+// pointer to function called for each record visited by a mapped index range query, with given context
+// returns false to stop the query
+typedef bool (*RecordFunc)(Pointer key, Pointer value, void *context);
+
+// pointer to function called with the item of each expired timer of a timer wheel
+typedef void (*ExpireFunc)(Pointer);
+
+// pointer to function that visits given element with given context, used by the for_each functions
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
+// pointer to function that runs a task of a thread pool with given argument
+typedef void (*TaskFunc)(Pointer);
+
 // pointer to function printing red_black tree's item
 typedef void (*PrintFunc)(Pointer);
 
+// pointer to function that writes given element to given stream, used for tree snapshots
+// returns true if the element was written successfully
+typedef bool (*SerializeFunc)(Pointer, FILE *);
+
+// pointer to function that reads an element, written by a SerializeFunc, from given stream
+// returns NULL if no element could be read
+typedef Pointer (*DeserializeFunc)(FILE *);
+
 ////////////////////////////////////////////////////////////////////
 
+// Links of the intrusive modules (struct adt_list_link, struct adt_rb_link), embedded in the user's structs,
+// and ADT_CONTAINER_OF, which returns the struct containing a link
+#include "../modules/Links/Links.h"
+
+// pointer to function that destroys or prints the struct containing given link of an intrusive list/tree
+typedef void (*ListLinkFunc)(struct adt_list_link *);
+typedef void (*RBLinkFunc)(struct adt_rb_link *);
+
+// pointers to functions that compare the structs containing two links of an intrusive tree,
+// or a key with the struct containing a link (see CompareFunc)
+typedef int (*LinkCompareFunc)(struct adt_rb_link *, struct adt_rb_link *);
+typedef int (*KeyCompareFunc)(Pointer, struct adt_rb_link *);
+
 // Pointers to modules' structs
 typedef struct stack_struct *Stack;
 typedef struct queue *Queue;
 typedef struct deque *Deque;
+typedef struct monotonic_deque *MonotonicDeque;
 typedef struct priority_queue *PriorityQueue;
+typedef struct radix_heap *RadixHeap;
 typedef struct circular_list *CircularList;
+typedef struct timer_wheel *TimerWheel;
+typedef struct tw_timer *Timer;
 typedef struct binary_search_tree *BinarySearchTree;
 typedef struct red_black_tree *RedBlackTree;
+typedef struct persistent_tree *PersistentTree;
+typedef struct read_mostly_tree *ReadMostlyTree;
+typedef struct skip_list *SkipList;
+typedef struct sharded_map *ShardedMap;
+typedef struct epoch_domain *EpochDomain;
+typedef struct concurrent_stack *ConcurrentStack;
+typedef struct frozen_index *FrozenIndex;
+typedef struct mapped_index *MappedIndex;
+typedef struct thread_pool *ThreadPool;
+typedef struct intrusive_list *IntrusiveList;
+typedef struct intrusive_rbt *IntrusiveRedBlackTree;
+typedef struct tp_task *Task;
 
 ////////////////////////////////////////////////////////////////////
 
@@ -41,11 +113,16 @@ typedef struct red_black_tree *RedBlackTree;
 void stack_initialize(Stack *, DestroyFunc, PrintFunc);
 void stack_push(Pointer, Stack);
 Pointer stack_pop(Stack);
+void stack_for_each(Stack, VisitFunc, void *);
+void stack_iterator_init(StackIterator *, Stack);
+Pointer stack_iterator_next(StackIterator *);
 void stack_print(Stack);
 void stack_destroy(Stack);
-int stack_size(Stack);
+size_t stack_size(Stack);
 bool stack_is_empty(Stack);
 Pointer stack_top(Stack);
+AdtStats stack_get_stats(Stack);
+void stack_reset_stats(Stack);
 void stack_set_destroy(Stack, DestroyFunc);
 void stack_set_print(Stack, PrintFunc);
 
@@ -53,12 +130,18 @@ void stack_set_print(Stack, PrintFunc);
 void queue_initialize(Queue *, DestroyFunc, PrintFunc);
 void queue_insert(Pointer, Queue);
 Pointer queue_remove(Queue);
+void queue_concat(Queue, Queue);
+void queue_for_each(Queue, VisitFunc, void *);
+void queue_iterator_init(QueueIterator *, Queue);
+Pointer queue_iterator_next(QueueIterator *);
 void queue_print(Queue);
 void queue_destroy(Queue);
-int queue_size(Queue);
+size_t queue_size(Queue);
 bool queue_is_empty(Queue);
 Pointer queue_front(Queue);
 Pointer queue_rear(Queue);
+AdtStats queue_get_stats(Queue);
+void queue_reset_stats(Queue);
 void queue_set_destroy(Queue, DestroyFunc);
 void queue_set_print(Queue, PrintFunc);
 
@@ -68,52 +151,135 @@ void deque_insert_back(Pointer, Deque);
 void deque_insert_front(Pointer, Deque);
 Pointer deque_remove_back(Deque);
 Pointer deque_remove_front(Deque);
+void deque_concat(Deque, Deque);
+void deque_split_at(size_t, Deque, Deque *);
+void deque_for_each(Deque, VisitFunc, void *);
+void deque_iterator_init(DequeIterator *, Deque);
+Pointer deque_iterator_next(DequeIterator *);
 void deque_print(Deque);
 void deque_destroy(Deque);
-int deque_size(Deque);
+size_t deque_size(Deque);
 bool deque_is_empty(Deque);
 Pointer deque_front(Deque);
 Pointer deque_rear(Deque);
+AdtStats deque_get_stats(Deque);
+void deque_reset_stats(Deque);
 void deque_set_destroy(Deque, DestroyFunc);
 void deque_set_print(Deque, PrintFunc);
 
+// Monotonic Deque
+void md_initialize(MonotonicDeque *, CompareFunc, DestroyFunc, PrintFunc);
+void md_push(Pointer, unsigned long, MonotonicDeque);
+size_t md_expire(unsigned long, MonotonicDeque);
+Pointer md_min(MonotonicDeque);
+unsigned long md_min_stamp(MonotonicDeque);
+void md_print(MonotonicDeque);
+void md_destroy(MonotonicDeque);
+size_t md_size(MonotonicDeque);
+bool md_is_empty(MonotonicDeque);
+AdtStats md_get_stats(MonotonicDeque);
+void md_reset_stats(MonotonicDeque);
+void md_set_destroy(MonotonicDeque, DestroyFunc);
+void md_set_print(MonotonicDeque, PrintFunc);
+
 // Priority Queue
 void pq_initialize(PriorityQueue *, CompareFunc, DestroyFunc, PrintFunc);
-void pq_insert(Pointer, PriorityQueue);
+void pq_initialize_from_array(PriorityQueue *, Pointer *, size_t, CompareFunc, DestroyFunc, PrintFunc);
+void pq_initialize_bounded(PriorityQueue *, size_t, CompareFunc, DestroyFunc, PrintFunc);
+Pointer pq_insert(Pointer, PriorityQueue);
+size_t pq_insert_many(Pointer *, size_t, PriorityQueue);
 Pointer pq_remove(PriorityQueue);
+size_t pq_remove_many(Pointer *, size_t, PriorityQueue);
+Pointer pq_worst(PriorityQueue);
+void pq_for_each(PriorityQueue, VisitFunc, void *);
+void pq_iterator_init(PQIterator *, PriorityQueue);
+Pointer pq_iterator_next(PQIterator *);
 void pq_print(PriorityQueue);
 void pq_destroy(PriorityQueue);
-int pq_size(PriorityQueue);
+size_t pq_size(PriorityQueue);
+size_t pq_bound(PriorityQueue);
 bool pq_is_empty(PriorityQueue);
+AdtStats pq_get_stats(PriorityQueue);
+void pq_reset_stats(PriorityQueue);
 void pq_set_compare(PriorityQueue, CompareFunc);
 void pq_set_destroy(PriorityQueue, DestroyFunc);
 void pq_set_print(PriorityQueue, PrintFunc);
 
+// Radix Heap
+void rh_initialize(RadixHeap *, KeyFunc, DestroyFunc, PrintFunc);
+bool rh_insert(Pointer, RadixHeap);
+Pointer rh_remove(RadixHeap);
+unsigned long rh_last_key(RadixHeap);
+void rh_print(RadixHeap);
+void rh_destroy(RadixHeap);
+size_t rh_size(RadixHeap);
+bool rh_is_empty(RadixHeap);
+AdtStats rh_get_stats(RadixHeap);
+void rh_reset_stats(RadixHeap);
+void rh_set_key(RadixHeap, KeyFunc);
+void rh_set_destroy(RadixHeap, DestroyFunc);
+void rh_set_print(RadixHeap, PrintFunc);
+
 // Circular List
 void cl_initialize(CircularList *, DestroyFunc, PrintFunc);
 void cl_insert(Pointer, CircularList);
+void cl_insert_before(Pointer, CircularList);
 Pointer cl_remove(CircularList);
+Pointer cl_remove_cursor(CircularList);
+void cl_for_each(CircularList, VisitFunc, void *);
+void cl_iterator_init(CLIterator *, CircularList);
+Pointer cl_iterator_next(CLIterator *);
 void cl_print(CircularList);
 void cl_destroy(CircularList);
-int cl_size(CircularList);
+size_t cl_size(CircularList);
 bool cl_is_empty(CircularList);
 void cl_advance_cursor(CircularList);
+void cl_retreat_cursor(CircularList);
 Pointer cl_cursor(CircularList);
+AdtStats cl_get_stats(CircularList);
+void cl_reset_stats(CircularList);
 void cl_set_destroy(CircularList, DestroyFunc);
 void cl_set_print(CircularList, PrintFunc);
 
+// Timer Wheel
+void tw_initialize(TimerWheel *, ExpireFunc, DestroyFunc, PrintFunc);
+Timer tw_schedule(Pointer, unsigned long, TimerWheel);
+Pointer tw_cancel(Timer, TimerWheel);
+size_t tw_tick(TimerWheel);
+size_t tw_advance(unsigned long, TimerWheel);
+unsigned long tw_now(TimerWheel);
+void tw_print(TimerWheel);
+void tw_destroy(TimerWheel);
+size_t tw_size(TimerWheel);
+bool tw_is_empty(TimerWheel);
+AdtStats tw_get_stats(TimerWheel);
+void tw_reset_stats(TimerWheel);
+void tw_set_expire(TimerWheel, ExpireFunc);
+void tw_set_destroy(TimerWheel, DestroyFunc);
+void tw_set_print(TimerWheel, PrintFunc);
+
 // Binary Search Tree
 void bst_initialize(BinarySearchTree *, CompareFunc, DestroyFunc, PrintFunc);
 void bst_insert(Pointer, BinarySearchTree);
 void bst_remove(Pointer, BinarySearchTree);
+void bst_for_each(BinarySearchTree, VisitFunc, void *);
+void bst_iterator_init(BSTIterator *, BinarySearchTree);
+Pointer bst_iterator_next(BSTIterator *);
 void bst_print(BinarySearchTree);
 void bst_destroy(BinarySearchTree);
-int bst_size(BinarySearchTree);
+bool bst_save(BinarySearchTree, FILE *, SerializeFunc);
+bool bst_load(BinarySearchTree *, FILE *, DeserializeFunc, CompareFunc, DestroyFunc, PrintFunc);
+size_t bst_size(BinarySearchTree);
 bool bst_is_empty(BinarySearchTree);
 bool bst_search(Pointer, BinarySearchTree);
 Pointer bst_root(BinarySearchTree);
 Pointer bst_min(BinarySearchTree);
 Pointer bst_max(BinarySearchTree);
+int bst_height(BinarySearchTree);
+int bst_depth_histogram(BinarySearchTree, size_t *, int);
+bool bst_verify(BinarySearchTree);
+AdtStats bst_get_stats(BinarySearchTree);
+void bst_reset_stats(BinarySearchTree);
 void bst_set_compare(BinarySearchTree, CompareFunc);
 void bst_set_destroy(BinarySearchTree, DestroyFunc);
 void bst_set_print(BinarySearchTree, PrintFunc);
@@ -122,16 +288,197 @@ void bst_set_print(BinarySearchTree, PrintFunc);
 void red_black_initialize(RedBlackTree *, CompareFunc, DestroyFunc, PrintFunc);
 void red_black_insert(Pointer, RedBlackTree);
 void red_black_remove(Pointer, RedBlackTree);
+bool red_black_join(RedBlackTree, RedBlackTree);
+Pointer red_black_split(Pointer, RedBlackTree, RedBlackTree *);
+void red_black_union(RedBlackTree, RedBlackTree);
+void red_black_intersect(RedBlackTree, RedBlackTree);
+void red_black_difference(RedBlackTree, RedBlackTree);
+void red_black_insert_many_parallel(Pointer *, size_t, RedBlackTree, ThreadPool);
+void red_black_union_parallel(RedBlackTree, RedBlackTree, ThreadPool);
+void red_black_for_each(RedBlackTree, VisitFunc, void *);
+void red_black_iterator_init(RBTIterator *, RedBlackTree);
+Pointer red_black_iterator_next(RBTIterator *);
 void red_black_print(RedBlackTree);
 void red_black_destroy(RedBlackTree);
-int red_black_size(RedBlackTree);
+void red_black_for_each_parallel(RedBlackTree, VisitFunc, void *, ThreadPool);
+void red_black_destroy_parallel(RedBlackTree, ThreadPool);
+bool red_black_save(RedBlackTree, FILE *, SerializeFunc);
+bool red_black_load(RedBlackTree *, FILE *, DeserializeFunc, CompareFunc, DestroyFunc, PrintFunc);
+FrozenIndex red_black_freeze(RedBlackTree);
+bool red_black_export(RedBlackTree, const char *, EncodeFunc, int, int);
+size_t red_black_size(RedBlackTree);
 bool red_black_is_empty(RedBlackTree);
 bool red_black_search(Pointer, RedBlackTree);
+Pointer red_black_find(Pointer, RedBlackTree);
+size_t red_black_search_batch(Pointer *, size_t, Pointer *, RedBlackTree);
 Pointer red_black_root(RedBlackTree);
 Pointer red_black_min(RedBlackTree);
 Pointer red_black_max(RedBlackTree);
+int red_black_height(RedBlackTree);
+int red_black_black_height(RedBlackTree);
+int red_black_depth_histogram(RedBlackTree, size_t *, int);
+bool red_black_verify(RedBlackTree);
+AdtStats red_black_get_stats(RedBlackTree);
+void red_black_reset_stats(RedBlackTree);
 void red_black_set_compare(RedBlackTree, CompareFunc);
 void red_black_set_destroy(RedBlackTree, DestroyFunc);
 void red_black_set_print(RedBlackTree, PrintFunc);
 
+// Persistent Tree
+void ptree_initialize(PersistentTree *, CompareFunc, DestroyFunc, PrintFunc);
+PersistentTree ptree_insert(Pointer, PersistentTree);
+PersistentTree ptree_remove(Pointer, PersistentTree);
+PersistentTree ptree_snapshot(PersistentTree);
+void ptree_print(PersistentTree);
+void ptree_destroy(PersistentTree);
+size_t ptree_size(PersistentTree);
+bool ptree_is_empty(PersistentTree);
+bool ptree_search(Pointer, PersistentTree);
+Pointer ptree_find(Pointer, PersistentTree);
+Pointer ptree_min(PersistentTree);
+Pointer ptree_max(PersistentTree);
+void ptree_set_destroy(PersistentTree, DestroyFunc);
+void ptree_set_print(PersistentTree, PrintFunc);
+
+// Read-Mostly Tree
+bool rmt_initialize(ReadMostlyTree *, CompareFunc, DestroyFunc, PrintFunc);
+void rmt_initialize_shared(ReadMostlyTree *, EpochDomain, CompareFunc, DestroyFunc, PrintFunc);
+bool rmt_insert(Pointer, ReadMostlyTree);
+bool rmt_remove(Pointer, ReadMostlyTree);
+bool rmt_search(Pointer, ReadMostlyTree);
+Pointer rmt_find(Pointer, ReadMostlyTree);
+Pointer rmt_min(ReadMostlyTree);
+Pointer rmt_max(ReadMostlyTree);
+PersistentTree rmt_snapshot(ReadMostlyTree);
+void rmt_print(ReadMostlyTree);
+void rmt_destroy(ReadMostlyTree);
+size_t rmt_size(ReadMostlyTree);
+bool rmt_is_empty(ReadMostlyTree);
+EpochDomain rmt_epoch(ReadMostlyTree);
+void rmt_set_destroy(ReadMostlyTree, DestroyFunc);
+void rmt_set_print(ReadMostlyTree, PrintFunc);
+
+// Intrusive List
+void ilist_initialize(IntrusiveList *, ListLinkFunc, ListLinkFunc);
+void ilist_insert_back(struct adt_list_link *, IntrusiveList);
+void ilist_insert_front(struct adt_list_link *, IntrusiveList);
+void ilist_insert_after(struct adt_list_link *, struct adt_list_link *, IntrusiveList);
+struct adt_list_link *ilist_remove_front(IntrusiveList);
+struct adt_list_link *ilist_remove_back(IntrusiveList);
+void ilist_remove(struct adt_list_link *, IntrusiveList);
+void ilist_rotate(IntrusiveList);
+void ilist_concat(IntrusiveList, IntrusiveList);
+struct adt_list_link *ilist_next(struct adt_list_link *, IntrusiveList);
+struct adt_list_link *ilist_prev(struct adt_list_link *, IntrusiveList);
+bool ilist_is_linked(struct adt_list_link *);
+void ilist_print(IntrusiveList);
+void ilist_destroy(IntrusiveList);
+size_t ilist_size(IntrusiveList);
+bool ilist_is_empty(IntrusiveList);
+struct adt_list_link *ilist_front(IntrusiveList);
+struct adt_list_link *ilist_back(IntrusiveList);
+void ilist_set_destroy(IntrusiveList, ListLinkFunc);
+void ilist_set_print(IntrusiveList, ListLinkFunc);
+
+// Intrusive Red Black Tree
+void irbt_initialize(IntrusiveRedBlackTree *, LinkCompareFunc, KeyCompareFunc, RBLinkFunc, RBLinkFunc);
+struct adt_rb_link *irbt_insert(struct adt_rb_link *, IntrusiveRedBlackTree);
+void irbt_remove(struct adt_rb_link *, IntrusiveRedBlackTree);
+struct adt_rb_link *irbt_find(Pointer, IntrusiveRedBlackTree);
+struct adt_rb_link *irbt_min(IntrusiveRedBlackTree);
+struct adt_rb_link *irbt_max(IntrusiveRedBlackTree);
+struct adt_rb_link *irbt_next(struct adt_rb_link *);
+struct adt_rb_link *irbt_prev(struct adt_rb_link *);
+void irbt_print(IntrusiveRedBlackTree);
+void irbt_destroy(IntrusiveRedBlackTree);
+size_t irbt_size(IntrusiveRedBlackTree);
+bool irbt_is_empty(IntrusiveRedBlackTree);
+void irbt_set_destroy(IntrusiveRedBlackTree, RBLinkFunc);
+void irbt_set_print(IntrusiveRedBlackTree, RBLinkFunc);
+
+// Skip List
+bool sl_initialize(SkipList *, CompareFunc, DestroyFunc, PrintFunc);
+void sl_initialize_shared(SkipList *, EpochDomain, CompareFunc, DestroyFunc, PrintFunc);
+bool sl_insert(Pointer, SkipList);
+bool sl_remove(Pointer, SkipList);
+bool sl_search(Pointer, SkipList);
+Pointer sl_find(Pointer, SkipList);
+size_t sl_range(Pointer, Pointer, VisitFunc, void *, SkipList);
+void sl_for_each(SkipList, VisitFunc, void *);
+void sl_print(SkipList);
+void sl_destroy(SkipList);
+EpochDomain sl_epoch(SkipList);
+size_t sl_size(SkipList);
+bool sl_is_empty(SkipList);
+void sl_set_destroy(SkipList, DestroyFunc);
+void sl_set_print(SkipList, PrintFunc);
+
+// Sharded Map
+void sm_initialize(ShardedMap *, int, ShardFunc, CompareFunc, DestroyFunc, PrintFunc);
+bool sm_insert(Pointer, ShardedMap);
+bool sm_remove(Pointer, ShardedMap);
+bool sm_search(Pointer, ShardedMap);
+Pointer sm_find(Pointer, ShardedMap);
+void sm_for_each(ShardedMap, VisitFunc, void *);
+void sm_print(ShardedMap);
+void sm_destroy(ShardedMap);
+size_t sm_size(ShardedMap);
+bool sm_is_empty(ShardedMap);
+int sm_shards(ShardedMap);
+void sm_set_destroy(ShardedMap, DestroyFunc);
+void sm_set_print(ShardedMap, PrintFunc);
+
+// Epoch
+bool ep_initialize(EpochDomain *);
+void ep_register(EpochDomain);
+void ep_unregister(EpochDomain);
+void ep_enter(EpochDomain);
+void ep_exit(EpochDomain);
+void ep_retire(Pointer, DestroyFunc, EpochDomain);
+size_t ep_collect(EpochDomain);
+size_t ep_pending(EpochDomain);
+void ep_destroy(EpochDomain);
+
+// Concurrent Stack
+void cs_initialize(ConcurrentStack *, DestroyFunc, PrintFunc);
+void cs_push(Pointer, ConcurrentStack);
+void cs_push_many(Pointer *, size_t, ConcurrentStack);
+Pointer cs_pop(ConcurrentStack);
+void cs_print(ConcurrentStack);
+void cs_destroy(ConcurrentStack);
+size_t cs_size(ConcurrentStack);
+bool cs_is_empty(ConcurrentStack);
+void cs_set_destroy(ConcurrentStack, DestroyFunc);
+void cs_set_print(ConcurrentStack, PrintFunc);
+
+// Frozen Index
+void fi_initialize_from_sorted(FrozenIndex *, Pointer *, size_t, CompareFunc, DestroyFunc, PrintFunc);
+bool fi_search(Pointer, FrozenIndex);
+Pointer fi_find(Pointer, FrozenIndex);
+Pointer fi_lower_bound(Pointer, FrozenIndex);
+Pointer fi_min(FrozenIndex);
+Pointer fi_max(FrozenIndex);
+void fi_print(FrozenIndex);
+void fi_destroy(FrozenIndex);
+size_t fi_size(FrozenIndex);
+bool fi_is_empty(FrozenIndex);
+void fi_set_destroy(FrozenIndex, DestroyFunc);
+void fi_set_print(FrozenIndex, PrintFunc);
+
+// Mapped Index
+bool mi_write_sorted(const char *, Pointer *, size_t, EncodeFunc, int, int);
+bool mi_open(MappedIndex *, const char *, CompareFunc);
+Pointer mi_search(Pointer, MappedIndex);
+size_t mi_range(Pointer, Pointer, RecordFunc, void *, MappedIndex);
+size_t mi_size(MappedIndex);
+bool mi_is_empty(MappedIndex);
+void mi_close(MappedIndex);
+
+// Thread Pool
+void tp_initialize(ThreadPool *, int);
+Task tp_spawn(TaskFunc, Pointer, ThreadPool);
+void tp_wait(Task, ThreadPool);
+int tp_threads(ThreadPool);
+void tp_destroy(ThreadPool);
+
 #endif
\ No newline at end of file
@@ -1,8 +1,14 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <assert.h>
 #include "BinarySearchTree.h"
 
+// header of a tree snapshot stream (shared with the RBT module, so snapshots of both trees are interchangeable)
+#define SNAPSHOT_MAGIC "ADTS"
+#define SNAPSHOT_VERSION 1
+
 // bst node struct
 typedef struct bst_node{
     Pointer data; // pointer to the node data
@@ -13,7 +19,10 @@ typedef struct bst_node{
 // bst struct
 struct binary_search_tree{
     bst_node *root; // pointer to the root of the bst
-    int size; // number of elements in the bst
+    size_t size; // number of elements in the bst
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
     CompareFunc Compare;
     DestroyFunc Destroy;
     PrintFunc Print;
@@ -32,16 +41,17 @@ static bst_node *new_bst_node(Pointer item)
     return new_node;
 }
 
-// finds the bst node of given item
+// finds the bst node of given item, in the subtree of root_node
 // returns NULL if not found
-static bst_node *find_node(bst_node *root_node, Pointer item, CompareFunc compare)
+static bst_node *find_node(bst_node *root_node, Pointer item, BinarySearchTree bst)
 {
     if (root_node == NULL) return NULL;
-    int comp_result = compare(item, root_node->data);
+    STATS_INC(bst, comparisons);
+    int comp_result = bst->Compare(item, root_node->data);
     if (!comp_result) return root_node; // found
     // search in the appropriate root's subtree
-    if (comp_result < 0) return find_node(root_node->left, item, compare);
-    else return find_node(root_node->right, item, compare);
+    if (comp_result < 0) return find_node(root_node->left, item, bst);
+    else return find_node(root_node->right, item, bst);
 }
 
 // finds the parent bst node of given item
@@ -120,6 +130,32 @@ static void print_tree_nodes(bst_node *node, PrintFunc print)
     print_tree_nodes(node->right, print);
 }
 
+// visits given bst's nodes in-order with given VisitFunc
+// returns false if a visit returned false, which stops the traversal
+static bool visit_nodes(bst_node *node, VisitFunc visit, void *context)
+{
+    if (node == NULL) return true;
+    return visit_nodes(node->left, visit, context) && visit(node->data, context) && visit_nodes(node->right, visit, context);
+}
+
+// returns the node with the next item in-order after the item of given node, or NULL if there is none
+// if node has no right subtree, its successor is the last node where the path from the root down to node turns left
+// (the nodes have no parent pointers, so that path is searched again)
+static bst_node *next_node(bst_node *node, BinarySearchTree bst)
+{
+    if (node->right != NULL) return in_order_successor(node);
+    bst_node *successor = NULL, *current = bst->root;
+    while (current != node){
+        STATS_INC(bst, comparisons);
+        if (bst->Compare(node->data, current->data) < 0){
+            successor = current;
+            current = current->left;
+        }
+        else current = current->right;
+    }
+    return successor;
+}
+
 // destroys given bst 
 static void destroy_nodes(bst_node *node, DestroyFunc destroy_func)
 {
@@ -130,6 +166,65 @@ static void destroy_nodes(bst_node *node, DestroyFunc destroy_func)
     free(node);
 }
 
+// returns the height (number of levels) of the subtree of given node
+static int tree_height(bst_node *node)
+{
+    if (node == NULL) return 0;
+    int left = tree_height(node->left), right = tree_height(node->right);
+    return 1 + (left > right ? left : right);
+}
+
+// counts the nodes of the subtree of given node per depth, for depths smaller than length
+static void count_depths(bst_node *node, int depth, size_t *histogram, int length)
+{
+    if (node == NULL || depth >= length) return;
+    histogram[depth]++;
+    count_depths(node->left, depth + 1, histogram, length);
+    count_depths(node->right, depth + 1, histogram, length);
+}
+
+// checks that the subtree of given node is visited in strictly ascending order, with prev being the last visited node
+// returns false if the ordering is violated
+static bool verify_nodes(bst_node *node, bst_node **prev, size_t *count, BinarySearchTree bst)
+{
+    if (node == NULL) return true;
+    if (!verify_nodes(node->left, prev, count, bst)) return false;
+    if (*prev != NULL){
+        STATS_INC(bst, comparisons);
+        if (bst->Compare((*prev)->data, node->data) >= 0) return false;
+    }
+    *prev = node;
+    (*count)++;
+    return verify_nodes(node->right, prev, count, bst);
+}
+
+// writes the items of given bst nodes to the stream in-order, based on given SerializeFunc
+static bool save_tree_nodes(bst_node *node, FILE *stream, SerializeFunc serialize)
+{
+    if (node == NULL) return true;
+    return save_tree_nodes(node->left, stream, serialize) && serialize(node->data, stream) &&
+           save_tree_nodes(node->right, stream, serialize);
+}
+
+// builds a balanced bst of n nodes, reading their items in-order from the stream
+// if an item can't be read, ok becomes false and the nodes built so far are returned
+static bst_node *load_tree_nodes(uint64_t n, FILE *stream, DeserializeFunc deserialize, bool *ok)
+{
+    if (n == 0 || !*ok) return NULL;
+    // the middle item is the root; the first half of the items goes to its left subtree
+    uint64_t left_size = (n - 1) / 2;
+    bst_node *left = load_tree_nodes(left_size, stream, deserialize, ok);
+    Pointer item = *ok ? deserialize(stream) : NULL;
+    if (item == NULL){
+        *ok = false;
+        return left;
+    }
+    bst_node *node = new_bst_node(item);
+    node->left = left;
+    node->right = load_tree_nodes(n - 1 - left_size, stream, deserialize, ok);
+    return node;
+}
+
 // Binary Search Tree (BST) ADT functions
 
 // initializes an empty bst
@@ -139,6 +234,7 @@ void bst_initialize(BinarySearchTree *bst, CompareFunc compare_func, DestroyFunc
     assert(*bst);
     (*bst)->root = NULL;
     (*bst)->size = 0;
+    bst_reset_stats(*bst);
     bst_set_compare(*bst, compare_func);
     bst_set_destroy(*bst, destroy_func);
     bst_set_print(*bst, print_func);
@@ -148,43 +244,81 @@ void bst_initialize(BinarySearchTree *bst, CompareFunc compare_func, DestroyFunc
 void bst_insert(Pointer item, BinarySearchTree bst)
 {
     bst_node *new_node = new_bst_node(item);
+    STATS_INC(bst, allocations);
     // check if tree is empty
     if (bst_is_empty(bst)){
         // insert the root
         bst->root = new_node;
         bst->size++;
+        STATS_INC(bst, inserts);
+        STATS_MAX(bst, peak_size, bst->size);
         return;
     }
     // pointer parent has the parent of the new node
     bst_node *parent = NULL;
     bst_node *current = bst->root;
+    int comp_result = 0, depth = 0;
     // traverse the tree and find the right place to insert the new node
     while (current != NULL){
         parent = current;
-        int comp_result = bst->Compare(new_node->data, current->data);
+        STATS_INC(bst, comparisons);
+        comp_result = bst->Compare(new_node->data, current->data);
         if (!comp_result){
             // item already exists, no duplicates are allowed
             free(new_node);
+            STATS_INC(bst, frees);
             return;
         }
         else if (comp_result < 0) current = current->left; // go in left subtree
         else current = current->right; // go in right subtree
+        depth++;
     }
-    // find which child of parent is the new_node; connect to the bst
-    if (bst->Compare(new_node->data, parent->data) < 0) parent->left = new_node;
+    // find which child of parent is the new_node (based on the last comparison); connect to the bst
+    if (comp_result < 0) parent->left = new_node;
     else parent->right = new_node;
     bst->size++;
+    STATS_INC(bst, inserts);
+    STATS_MAX(bst, peak_size, bst->size);
+    STATS_MAX(bst, max_depth, depth);
 }
 
 // removes and destroys given item from the bst
 void bst_remove(Pointer item, BinarySearchTree bst)
 {
     if (bst_is_empty(bst)) return;
-    bst_node *node = find_node(bst->root, item, bst->Compare);
+    bst_node *node = find_node(bst->root, item, bst);
     if (node == NULL) return;
     // remove node from bst and return bst's new form
     bst->root = node_remove(bst->root, node, bst->Destroy);
     bst->size--;
+    STATS_INC(bst, removes);
+    STATS_INC(bst, frees);
+}
+
+// visits the items of the bst in-order with given VisitFunc, until a visit returns false
+void bst_for_each(BinarySearchTree bst, VisitFunc visit, void *context)
+{
+    visit_nodes(bst->root, visit, context);
+}
+
+// initializes given iterator at the smallest item of the bst
+void bst_iterator_init(BSTIterator *it, BinarySearchTree bst)
+{
+    it->bst = bst;
+    it->node = bst->root;
+    if (it->node != NULL){
+        while (it->node->left != NULL) it->node = it->node->left;
+    }
+}
+
+// returns the next item of the iterator, or NULL after the last one
+// O(1) amortized if the items were visited through right subtrees, else O(h) to find the successor from the root
+Pointer bst_iterator_next(BSTIterator *it)
+{
+    if (it->node == NULL) return NULL;
+    Pointer item = it->node->data;
+    it->node = next_node(it->node, it->bst);
+    return item;
 }
 
 // prints items of the bst 
@@ -203,8 +337,45 @@ void bst_destroy(BinarySearchTree bst)
     free(bst);
 }
 
+// writes a snapshot of the bst to given stream: a header followed by the items in-order
+// returns true on success
+bool bst_save(BinarySearchTree bst, FILE *stream, SerializeFunc serialize)
+{
+    uint32_t version = SNAPSHOT_VERSION;
+    uint64_t count = bst->size;
+    if (fwrite(SNAPSHOT_MAGIC, 1, 4, stream) != 4 || fwrite(&version, sizeof(version), 1, stream) != 1 ||
+        fwrite(&count, sizeof(count), 1, stream) != 1) return false;
+    return save_tree_nodes(bst->root, stream, serialize);
+}
+
+// initializes a bst from a snapshot written by bst_save (or red_black_save)
+// the tree is built balanced, in O(n) without comparing items, since the items are already sorted
+// returns false if the snapshot can't be read; the tree is then left empty
+bool bst_load(BinarySearchTree *bst, FILE *stream, DeserializeFunc deserialize, CompareFunc compare_func, DestroyFunc destroy_func, PrintFunc print_func)
+{
+    bst_initialize(bst, compare_func, destroy_func, print_func);
+    // read and check the header
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    if (fread(magic, 1, 4, stream) != 4 || memcmp(magic, SNAPSHOT_MAGIC, 4) ||
+        fread(&version, sizeof(version), 1, stream) != 1 || version != SNAPSHOT_VERSION ||
+        fread(&count, sizeof(count), 1, stream) != 1) return false;
+    bool ok = true;
+    bst_node *root = load_tree_nodes(count, stream, deserialize, &ok);
+    if (!ok){
+        destroy_nodes(root, destroy_func);
+        return false;
+    }
+    (*bst)->root = root;
+    (*bst)->size = count;
+    bst_reset_stats(*bst);
+    STATS_ADD(*bst, allocations, count);
+    return true;
+}
+
 // returns the number of elements in the bst
-int bst_size(BinarySearchTree bst)
+size_t bst_size(BinarySearchTree bst)
 {
     return bst->size;
 }
@@ -219,7 +390,7 @@ bool bst_is_empty(BinarySearchTree bst)
 // returns true/false based on if given item is found in the bst or not
 bool bst_search(Pointer item, BinarySearchTree bst)
 {
-    return find_node(bst->root, item, bst->Compare) != NULL ? true : false;
+    return find_node(bst->root, item, bst) != NULL ? true : false;
 }
 
 // returns the root element of the bst
@@ -246,6 +417,51 @@ Pointer bst_max(BinarySearchTree bst)
     return max->data;
 }
 
+// returns the height (number of levels) of the bst, 0 if empty
+int bst_height(BinarySearchTree bst)
+{
+    return tree_height(bst->root);
+}
+
+// stores in histogram[d] the number of nodes at depth d (the root has depth 0), for every d < length
+// returns the height of the bst; a histogram of that length holds every depth
+int bst_depth_histogram(BinarySearchTree bst, size_t *histogram, int length)
+{
+    for (int d = 0; d < length; d++) histogram[d] = 0;
+    count_depths(bst->root, 0, histogram, length);
+    return bst_height(bst);
+}
+
+// checks in O(n) that the bst is valid: items in strictly ascending order and correct size
+bool bst_verify(BinarySearchTree bst)
+{
+    bst_node *prev = NULL;
+    size_t count = 0;
+    if (!verify_nodes(bst->root, &prev, &count, bst)) return false;
+    return count == bst->size;
+}
+
+// returns the operation counters of the bst
+AdtStats bst_get_stats(BinarySearchTree bst)
+{
+#ifdef ADT_STATS
+    return bst->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the bst; the peak size becomes the current size
+void bst_reset_stats(BinarySearchTree bst)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = bst->size;
+    bst->stats = stats;
+#endif
+}
+
 // sets as new CompareFunc of given bst the given one
 void bst_set_compare(BinarySearchTree bst, CompareFunc compare_func)
 {
@@ -3,7 +3,11 @@
 #ifndef BINARY_SEARCH_TREE_H
 #define BINARY_SEARCH_TREE_H
 
+#include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+#include "../Iterators/Iterators.h"
 
 // generic-pointer typedef
 typedef void *Pointer;
@@ -20,9 +24,24 @@ typedef void (*DestroyFunc)(Pointer);
 // pointer to function printing bst's item
 typedef void (*PrintFunc)(Pointer);
 
+// pointer to function that writes given element to given stream
+// returns true if the element was written successfully
+typedef bool (*SerializeFunc)(Pointer, FILE *);
+
+// pointer to function that reads an element, written by a SerializeFunc, from given stream
+// returns NULL if no element could be read
+typedef Pointer (*DeserializeFunc)(FILE *);
+
+// pointer to function that visits given element, with the context given to the visiting function
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
 // pointer to bst
 typedef struct binary_search_tree *BinarySearchTree;
 
+// iterator over the items of a bst (BSTIterator, defined in Iterators.h), in-order (ascending)
+// declared by the user (usually as a local variable); it stays valid as long as the bst isn't changed
+
 /*-----Functions Provided-----*/
 
 // initializes an empty bst
@@ -34,14 +53,32 @@ void bst_insert(Pointer, BinarySearchTree);
 // removes and destroys given item from the bst
 void bst_remove(Pointer, BinarySearchTree);
 
+// visits the items of the bst in-order (ascending) with given VisitFunc and context
+// stops once a visit returns false
+void bst_for_each(BinarySearchTree, VisitFunc, void *context);
+
+// initializes given iterator at the smallest item of the bst
+void bst_iterator_init(BSTIterator *, BinarySearchTree);
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer bst_iterator_next(BSTIterator *);
+
 // prints items of the bst 
 void bst_print(BinarySearchTree);
 
 // destroys the given bst by freeing all nodes
 void bst_destroy(BinarySearchTree);
 
+// writes a snapshot of the bst to given stream (a header and the items in-order)
+// returns true on success
+bool bst_save(BinarySearchTree, FILE *, SerializeFunc);
+
+// initializes a balanced bst from a snapshot written by bst_save or red_black_save, in O(n)
+// returns false if the snapshot can't be read; the tree is then initialized empty
+bool bst_load(BinarySearchTree *, FILE *, DeserializeFunc, CompareFunc, DestroyFunc, PrintFunc);
+
 // returns the number of elements in the bst
-int bst_size(BinarySearchTree);
+size_t bst_size(BinarySearchTree);
 
 // returns true/false depending on if bst is empty or not
 bool bst_is_empty(BinarySearchTree);
@@ -58,6 +95,22 @@ Pointer bst_min(BinarySearchTree);
 // returns the element with highest value
 Pointer bst_max(BinarySearchTree);
 
+// returns the height (number of levels) of the bst, 0 if empty
+int bst_height(BinarySearchTree);
+
+// stores in histogram[d] the number of nodes at depth d (root has depth 0), for every d < length
+// returns the height of the bst, so a histogram of that length holds all depths
+int bst_depth_histogram(BinarySearchTree, size_t *histogram, int length);
+
+// returns true if the bst is valid: items in order and correct size (O(n))
+bool bst_verify(BinarySearchTree);
+
+// returns the operation counters of the bst (see Stats.h)
+AdtStats bst_get_stats(BinarySearchTree);
+
+// resets the operation counters of the bst
+void bst_reset_stats(BinarySearchTree);
+
 // sets as new CompareFunc of given bst the given one
 void bst_set_compare(BinarySearchTree, CompareFunc);
 
@@ -7,16 +7,58 @@
 typedef struct cl_node{
     Pointer data; // pointer to the node data
     struct cl_node *next; // pointer to the next circular list node
+    struct cl_node *prev; // pointer to the previous circular list node
 }cl_node;
 
 // circular list struct
 struct circular_list{
     cl_node *cursor; // pointer to the cursor node of the circular list
-    int size; // number of elements in the circular list
+    size_t size; // number of elements in the circular list
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
     DestroyFunc Destroy;
     PrintFunc Print;
 };
 
+// circular list node functions
+
+// returns a new node with given item, linked between prev and next
+// or linked with itself, if the list is empty (prev and next are NULL)
+static cl_node *link_new_node(Pointer item, cl_node *prev, cl_node *next)
+{
+    cl_node *new_node = malloc(sizeof(cl_node));
+    assert(new_node);
+    new_node->data = item;
+    if (prev == NULL){
+        new_node->next = new_node;
+        new_node->prev = new_node;
+        return new_node;
+    }
+    new_node->prev = prev;
+    new_node->next = next;
+    prev->next = new_node;
+    next->prev = new_node;
+    return new_node;
+}
+
+// unlinks and frees given node of the circular list and returns its item
+static Pointer unlink_node(cl_node *node, CircularList cl)
+{
+    Pointer item = node->data;
+    cl->size--;
+    STATS_INC(cl, frees);
+    STATS_INC(cl, removes);
+    // check if it was the only node; the list becomes empty
+    if (cl_is_empty(cl)) cl->cursor = NULL;
+    else{
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+    }
+    free(node);
+    return item;
+}
+
 // Circular List ADT functions
 
 // initializes an empty circular list
@@ -26,6 +68,7 @@ void cl_initialize(CircularList *cl, DestroyFunc destroy_func, PrintFunc print_f
     assert(*cl);
     (*cl)->cursor = NULL;
     (*cl)->size = 0;
+    cl_reset_stats(*cl);
     cl_set_destroy(*cl, destroy_func);
     cl_set_print(*cl, print_func);
 }
@@ -33,20 +76,27 @@ void cl_initialize(CircularList *cl, DestroyFunc destroy_func, PrintFunc print_f
 // adds a new node to the circular list, right after the cursor or the cursor if cl was empty
 void cl_insert(Pointer item, CircularList cl)
 {
-    cl_node *new_node = malloc(sizeof(cl_node));
-    assert(new_node);
-    new_node->data = item;
     // check if list is empty; insert the cursor
-    if (cl_is_empty(cl)){
-        new_node->next = new_node;
-        cl->cursor = new_node;
-        cl->size++;
-        return;
-    }
+    if (cl_is_empty(cl)) cl->cursor = link_new_node(item, NULL, NULL);
     // else; insert right after the cursor
-    new_node->next = cl->cursor->next;
-    cl->cursor->next = new_node;
+    else link_new_node(item, cl->cursor, cl->cursor->next);
     cl->size++;
+    STATS_INC(cl, allocations);
+    STATS_INC(cl, inserts);
+    STATS_MAX(cl, peak_size, cl->size);
+}
+
+// adds a new node to the circular list, right before the cursor or the cursor if cl was empty
+void cl_insert_before(Pointer item, CircularList cl)
+{
+    // check if list is empty; insert the cursor
+    if (cl_is_empty(cl)) cl->cursor = link_new_node(item, NULL, NULL);
+    // else; insert right before the cursor
+    else link_new_node(item, cl->cursor->prev, cl->cursor);
+    cl->size++;
+    STATS_INC(cl, allocations);
+    STATS_INC(cl, inserts);
+    STATS_MAX(cl, peak_size, cl->size);
 }
 
 // removes and returns the node after the cursor 
@@ -55,20 +105,44 @@ Pointer cl_remove(CircularList cl)
 {
     // check if list is empty
     if (cl_is_empty(cl)) return NULL;
-    Pointer item;
-    // check if cl has only the cursor node; remove the cursor
-    if (cl_size(cl) == 1){
-        item = cl->cursor->data;
-        free(cl->cursor);
-        cl->size--;
-        return item;
+    // remove the node after the cursor (which is the cursor itself, if it's the only node)
+    return unlink_node(cl->cursor->next, cl);
+}
+
+// removes and returns the cursor node; the next node becomes the new cursor
+Pointer cl_remove_cursor(CircularList cl)
+{
+    // check if list is empty
+    if (cl_is_empty(cl)) return NULL;
+    cl_node *node = cl->cursor;
+    cl->cursor = node->next;
+    return unlink_node(node, cl);
+}
+
+// visits the items of the circular list once around, starting from the cursor, with given VisitFunc,
+// until a visit returns false
+void cl_for_each(CircularList cl, VisitFunc visit, void *context)
+{
+    cl_node *node = cl->cursor;
+    for (size_t i = 0; i < cl->size; i++, node = node->next){
+        if (!visit(node->data, context)) return;
     }
-    // else; remove the node after the cursor
-    item = cl->cursor->next->data;
-    cl_node *new_cursor_next = cl->cursor->next->next;
-    free(cl->cursor->next);
-    cl->size--;
-    cl->cursor->next = new_cursor_next;
+}
+
+// initializes given iterator at the cursor of the circular list
+void cl_iterator_init(CLIterator *it, CircularList cl)
+{
+    it->node = cl->cursor;
+    it->remaining = cl->size;
+}
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer cl_iterator_next(CLIterator *it)
+{
+    if (!it->remaining) return NULL;
+    Pointer item = it->node->data;
+    it->node = it->node->next;
+    it->remaining--;
     return item;
 }
 
@@ -89,25 +163,19 @@ void cl_print(CircularList cl)
 // destroys the given circular list
 void cl_destroy(CircularList cl)
 {
-    // check if circular list is empty
-    if (cl_is_empty(cl)){
-        free(cl);
-        return;
-    }
-    // else; destroy circular list's elements 
-    cl_node *node = cl->cursor->next;
-    while (!cl_is_empty(cl)){
-        if (cl->Destroy != NULL) cl->Destroy(cl->cursor->data);
-        free(cl->cursor);
-        cl->cursor = node;
-        if (node != NULL) node = node->next;
-        cl->size--;
+    // destroy circular list's elements, starting from the cursor
+    cl_node *node = cl->cursor;
+    for (size_t i = 0; i < cl->size; i++){
+        cl_node *next = node->next;
+        if (cl->Destroy != NULL) cl->Destroy(node->data);
+        free(node);
+        node = next;
     }
     free(cl);
 }
 
 // returns the number of elements in the circular list
-int cl_size(CircularList cl)
+size_t cl_size(CircularList cl)
 {
     return cl->size;
 }
@@ -122,9 +190,17 @@ bool cl_is_empty(CircularList cl)
 // advances the cursor of the circular list to the next node
 void cl_advance_cursor(CircularList cl)
 {
+    if (cl_is_empty(cl)) return;
     cl->cursor = cl->cursor->next;
 }
 
+// moves the cursor of the circular list back to the previous node
+void cl_retreat_cursor(CircularList cl)
+{
+    if (cl_is_empty(cl)) return;
+    cl->cursor = cl->cursor->prev;
+}
+
 // returns the cursor of given circular list or NULL if cl is empty
 Pointer cl_cursor(CircularList cl)
 {
@@ -132,6 +208,27 @@ Pointer cl_cursor(CircularList cl)
     else return cl->cursor->data;
 }
 
+// returns the operation counters of the circular list
+AdtStats cl_get_stats(CircularList cl)
+{
+#ifdef ADT_STATS
+    return cl->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the circular list; the peak size becomes the current size
+void cl_reset_stats(CircularList cl)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = cl->size;
+    cl->stats = stats;
+#endif
+}
+
 // sets as new DestroyFunc of given circular list the given one
 void cl_set_destroy(CircularList cl, DestroyFunc destroy_func)
 {
@@ -4,6 +4,9 @@
 #define CIRCULAR_LIST_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+#include "../Iterators/Iterators.h"
 
 // generic-pointer typedef
 typedef void *Pointer;
@@ -14,9 +17,16 @@ typedef void (*DestroyFunc)(Pointer);
 // pointer to function printing circular list's item
 typedef void (*PrintFunc)(Pointer);
 
+// pointer to function that visits given element, with the context given to the visiting function
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
 // pointer to circular list
 typedef struct circular_list *CircularList;
 
+// iterator over the items of a circular list (CLIterator, defined in Iterators.h), once around, starting from the cursor
+// declared by the user (usually as a local variable); it stays valid as long as the circular list isn't changed
+
 /*-----Functions Provided-----*/
 
 // initializes an empty circular list
@@ -25,10 +35,27 @@ void cl_initialize(CircularList *, DestroyFunc, PrintFunc);
 // inserts a new item in the cl right after the cursor or the cursor if the list was empty
 void cl_insert(Pointer, CircularList);
 
+// inserts a new item in the cl right before the cursor or the cursor if the list was empty
+void cl_insert_before(Pointer, CircularList);
+
 // removes and returns the item right after the cursor or the cursor if it was its only node
 // returns NULL if circular list is empty
 Pointer cl_remove(CircularList);
 
+// removes and returns the cursor's item; the cursor advances to the next node
+// returns NULL if circular list is empty
+Pointer cl_remove_cursor(CircularList);
+
+// visits the items of the circular list once around, starting from the cursor with given VisitFunc and context
+// stops once a visit returns false
+void cl_for_each(CircularList, VisitFunc, void *context);
+
+// initializes given iterator at the cursor of the circular list
+void cl_iterator_init(CLIterator *, CircularList);
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer cl_iterator_next(CLIterator *);
+
 // prints items of the circular list
 void cl_print(CircularList);
 
@@ -36,7 +63,7 @@ void cl_print(CircularList);
 void cl_destroy(CircularList);
 
 // returns the number of elements in the circular list
-int cl_size(CircularList);
+size_t cl_size(CircularList);
 
 // returns true/false depending on if circular list is empty or not
 bool cl_is_empty(CircularList);
@@ -44,9 +71,18 @@ bool cl_is_empty(CircularList);
 // advances the cursor to the next node
 void cl_advance_cursor(CircularList);
 
+// moves the cursor back to the previous node
+void cl_retreat_cursor(CircularList);
+
 // returns the cursor of given circular list or NULL if cl is empty
 Pointer cl_cursor(CircularList);
 
+// returns the operation counters of the circular list (see Stats.h)
+AdtStats cl_get_stats(CircularList);
+
+// resets the operation counters of the circular list
+void cl_reset_stats(CircularList);
+
 // sets as new DestroyFunc of given circular list the given one
 void cl_set_destroy(CircularList, DestroyFunc);
 
@@ -0,0 +1,343 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <assert.h>
+#include "ConcurrentStack.h"
+
+// the first chunk of nodes holds 2^CHUNK_BITS nodes, and every next chunk twice as many as the previous one
+#define CHUNK_BITS 6
+#define CHUNK_BASE (1ULL << CHUNK_BITS)
+
+// number of chunks needed for node indices up to 2^32 - 1
+#define MAX_CHUNKS (33 - CHUNK_BITS)
+
+// number of slots of the elimination array, and times a push waits in a slot for a pop to take its item
+#define ELIMINATION_SLOTS 8
+#define ELIMINATION_SPINS 256
+
+// number of size counters; every thread updates one of them, so that they don't all write the same cache line
+#define SIZE_STRIPES 16
+
+#ifdef __GNUC__
+#define HIGHEST_SET(x) (63 - __builtin_clzll(x))
+#else
+// returns the index of the most significant set bit of x (x must not be 0)
+static int HIGHEST_SET(uint64_t x)
+{
+    int bit = 0;
+    while (x >>= 1) bit++;
+    return bit;
+}
+#endif
+
+// stack node struct
+typedef struct cs_node{
+    Pointer data; // pointer to the node data
+    _Atomic uint32_t next; // index of the node below, or 0 at the bottom of the stack
+}cs_node;
+
+// head of a list of nodes (the stack or the free nodes), alone in its cache line
+// the low 32 bits hold the index of the first node and the high 32 bits a tag, increased on every change
+typedef struct tagged_head{
+    _Atomic uint64_t head;
+    char padding[64 - sizeof(uint64_t)];
+}tagged_head;
+
+// item offered by a push waiting in the elimination array
+typedef struct cs_exchange{
+    Pointer item; // the item being pushed
+    atomic_bool taken; // set by the pop that takes the item, once it has read it
+}cs_exchange;
+
+// slot of the elimination array, alone in its cache line
+typedef struct elimination_slot{
+    _Atomic(cs_exchange *) offer; // the offer of a waiting push, or NULL
+    char padding[64 - sizeof(cs_exchange *)];
+}elimination_slot;
+
+// size counter, alone in its cache line
+typedef struct size_stripe{
+    atomic_long count; // number of items pushed minus the number of items popped through the stripe
+    char padding[64 - sizeof(atomic_long)];
+}size_stripe;
+
+// concurrent stack struct
+/* Lock-free stack (Treiber): pushes and pops change the top of the stack with compare-and-swap only.
+   A pop reads the node below the top one before swapping the top, so it could be fooled if in the meantime
+   the top node were popped and pushed again (ABA). To prevent that, nodes are referenced by a 32-bit index
+   and the top holds a tag next to the index, which every change increases, so the swap fails instead.
+   Nodes are allocated in chunks of growing size and are never freed before the stack is destroyed:
+   popped nodes go to a (lock-free, tagged) free list, so a node read by a pop is always valid memory.
+   When a push or a pop fails to swap the top because of contention, it tries to meet a pop or a push in
+   a random slot of the elimination array (Hendler, Shavit, Yerushalmi); the two cancel out without
+   touching the top of the stack, so under heavy contention the threads spread over many cache lines.  */
+struct concurrent_stack{
+    tagged_head top; // the top of the stack
+    tagged_head free_nodes; // list of the popped nodes, reused by the next pushes
+    _Atomic(cs_node *) chunks[MAX_CHUNKS]; // chunks of nodes, allocated when first needed
+    _Atomic uint64_t allocated; // number of nodes allocated from the chunks
+    elimination_slot elimination[ELIMINATION_SLOTS]; // slots where pushes wait for pops
+    size_stripe size[SIZE_STRIPES]; // the number of elements is the sum of the counters
+    DestroyFunc Destroy;
+    PrintFunc Print;
+};
+
+// the stripe of the size counters and the random number generator state of the calling thread
+static _Thread_local unsigned thread_stripe;
+static _Thread_local uint64_t thread_random;
+static atomic_uint thread_count;
+
+// node functions
+
+// returns the index of the first node of given tagged head
+static uint32_t get_index(uint64_t head)
+{
+    return (uint32_t)head;
+}
+
+// returns a tagged head with given first node, and a tag greater than that of given old head
+static uint64_t next_head(uint32_t index, uint64_t old_head)
+{
+    return ((old_head >> 32) + 1) << 32 | index;
+}
+
+// returns the chunk of node with given index (nodes are numbered from 1)
+static int chunk_of(uint64_t index)
+{
+    return HIGHEST_SET(index - 1 + CHUNK_BASE) - CHUNK_BITS;
+}
+
+// returns the node with given index
+static cs_node *get_node(uint32_t index, ConcurrentStack cs)
+{
+    int chunk = chunk_of(index);
+    return &atomic_load(&cs->chunks[chunk])[index - 1 + CHUNK_BASE - (CHUNK_BASE << chunk)];
+}
+
+// pushes the chain of nodes from first to last on the list with given head
+static void push_chain(tagged_head *list, uint32_t first, cs_node *last)
+{
+    uint64_t head = atomic_load(&list->head);
+    do{
+        atomic_store_explicit(&last->next, get_index(head), memory_order_relaxed);
+    }while (!atomic_compare_exchange_weak(&list->head, &head, next_head(first, head)));
+}
+
+// tries once to pop the first node of the list with given head
+// returns true if it succeeds or the list is empty, with the index of the popped node (or 0) in *index
+static bool try_pop(tagged_head *list, uint32_t *index, ConcurrentStack cs)
+{
+    uint64_t head = atomic_load(&list->head);
+    *index = get_index(head);
+    if (*index == 0) return true;
+    // the node may be popped by another thread meanwhile, but it's never freed; if it is, the tag has changed
+    uint32_t next = atomic_load_explicit(&get_node(*index, cs)->next, memory_order_relaxed);
+    return atomic_compare_exchange_strong(&list->head, &head, next_head(next, head));
+}
+
+// pops the first node of the list with given head, and returns its index, or 0 if the list is empty
+static uint32_t pop_node(tagged_head *list, ConcurrentStack cs)
+{
+    uint32_t index;
+    while (!try_pop(list, &index, cs));
+    return index;
+}
+
+// returns the index of a node for a new item: a free one if there is any, else a newly allocated one
+static uint32_t allocate_node(ConcurrentStack cs)
+{
+    uint32_t index = pop_node(&cs->free_nodes, cs);
+    if (index != 0) return index;
+    uint64_t allocated = atomic_fetch_add_explicit(&cs->allocated, 1, memory_order_relaxed) + 1;
+    assert(allocated <= UINT32_MAX);
+    int chunk = chunk_of(allocated);
+    if (atomic_load(&cs->chunks[chunk]) == NULL){
+        // the first threads to need the chunk all allocate it, but only one of them installs it
+        cs_node *nodes = malloc((CHUNK_BASE << chunk) * sizeof(cs_node));
+        assert(nodes);
+        cs_node *expected = NULL;
+        if (!atomic_compare_exchange_strong(&cs->chunks[chunk], &expected, nodes)) free(nodes);
+    }
+    return allocated;
+}
+
+// returns the size stripe of the calling thread (assigned once per thread, round-robin)
+static size_stripe *get_stripe(ConcurrentStack cs)
+{
+    if (thread_random == 0){
+        thread_stripe = atomic_fetch_add_explicit(&thread_count, 1, memory_order_relaxed);
+        // the random generator is seeded from the thread's number and the address of its state
+        thread_random = ((uint64_t)thread_stripe + 1) * 0x9E3779B97F4A7C15ULL ^ (uintptr_t)&thread_random;
+        if (thread_random == 0) thread_random = 1;
+    }
+    return &cs->size[thread_stripe % SIZE_STRIPES];
+}
+
+// returns a random slot of the elimination array
+static elimination_slot *random_slot(ConcurrentStack cs)
+{
+    // xorshift64 generator of the calling thread (seeded by get_stripe)
+    thread_random ^= thread_random << 13;
+    thread_random ^= thread_random >> 7;
+    thread_random ^= thread_random << 17;
+    return &cs->elimination[thread_random % ELIMINATION_SLOTS];
+}
+
+// offers given item in a random slot of the elimination array and waits for a pop to take it
+// returns true if a pop took the item, false if the push has to be retried on the stack
+static bool eliminate_push(Pointer item, ConcurrentStack cs)
+{
+    elimination_slot *slot = random_slot(cs);
+    cs_exchange exchange, *expected = NULL;
+    exchange.item = item;
+    atomic_init(&exchange.taken, false);
+    if (!atomic_compare_exchange_strong(&slot->offer, &expected, &exchange)) return false;
+    for (int spin = 0; spin < ELIMINATION_SPINS; spin++){
+        if (atomic_load_explicit(&exchange.taken, memory_order_acquire)) return true;
+    }
+    // withdraw the offer; if it's gone, a pop took it, and the exchange must outlive the pop's read of the item
+    expected = &exchange;
+    if (atomic_compare_exchange_strong(&slot->offer, &expected, NULL)) return false;
+    while (!atomic_load_explicit(&exchange.taken, memory_order_acquire));
+    return true;
+}
+
+// takes the item offered in a random slot of the elimination array, if any
+// returns true if an item was taken, which is stored in *item
+static bool eliminate_pop(Pointer *item, ConcurrentStack cs)
+{
+    elimination_slot *slot = random_slot(cs);
+    cs_exchange *exchange = atomic_load(&slot->offer);
+    if (exchange == NULL || !atomic_compare_exchange_strong(&slot->offer, &exchange, NULL)) return false;
+    *item = exchange->item;
+    atomic_store_explicit(&exchange->taken, true, memory_order_release);
+    return true;
+}
+
+// Concurrent Stack ADT functions
+
+// initializes an empty concurrent stack
+void cs_initialize(ConcurrentStack *cs, DestroyFunc destroy, PrintFunc print)
+{
+    *cs = malloc(sizeof(struct concurrent_stack));
+    assert(*cs);
+    atomic_init(&(*cs)->top.head, 0);
+    atomic_init(&(*cs)->free_nodes.head, 0);
+    for (int i = 0; i < MAX_CHUNKS; i++) atomic_init(&(*cs)->chunks[i], NULL);
+    atomic_init(&(*cs)->allocated, 0);
+    for (int i = 0; i < ELIMINATION_SLOTS; i++) atomic_init(&(*cs)->elimination[i].offer, NULL);
+    for (int i = 0; i < SIZE_STRIPES; i++) atomic_init(&(*cs)->size[i].count, 0);
+    cs_set_destroy(*cs, destroy);
+    cs_set_print(*cs, print);
+}
+
+// pushes given item on top of the stack
+void cs_push(Pointer item, ConcurrentStack cs)
+{
+    size_stripe *stripe = get_stripe(cs);
+    uint32_t index = allocate_node(cs);
+    cs_node *node = get_node(index, cs);
+    node->data = item;
+    uint64_t head = atomic_load(&cs->top.head);
+    while (true){
+        atomic_store_explicit(&node->next, get_index(head), memory_order_relaxed);
+        if (atomic_compare_exchange_strong(&cs->top.head, &head, next_head(index, head))) break;
+        // contention; try to hand the item directly to a pop
+        if (eliminate_push(item, cs)){
+            push_chain(&cs->free_nodes, index, node);
+            return;
+        }
+        head = atomic_load(&cs->top.head);
+    }
+    atomic_fetch_add_explicit(&stripe->count, 1, memory_order_relaxed);
+}
+
+// pushes the n given items on top of the stack at once, so that the last one ends up on top
+void cs_push_many(Pointer *items, size_t n, ConcurrentStack cs)
+{
+    if (n == 0) return;
+    size_stripe *stripe = get_stripe(cs);
+    // link the nodes of the items privately, the last item first
+    uint32_t first = 0;
+    cs_node *last = NULL;
+    for (size_t i = 0; i < n; i++){
+        uint32_t index = allocate_node(cs);
+        cs_node *node = get_node(index, cs);
+        node->data = items[i];
+        if (first != 0) atomic_store_explicit(&node->next, first, memory_order_relaxed);
+        else last = node;
+        first = index;
+    }
+    push_chain(&cs->top, first, last);
+    atomic_fetch_add_explicit(&stripe->count, n, memory_order_relaxed);
+}
+
+// removes the top item of the stack and returns it, or NULL if the stack is empty
+Pointer cs_pop(ConcurrentStack cs)
+{
+    size_stripe *stripe = get_stripe(cs);
+    uint32_t index;
+    while (!try_pop(&cs->top, &index, cs)){
+        // contention; try to take the item of a push directly
+        Pointer item;
+        if (eliminate_pop(&item, cs)) return item;
+    }
+    if (index == 0) return NULL;
+    cs_node *node = get_node(index, cs);
+    Pointer item = node->data;
+    push_chain(&cs->free_nodes, index, node);
+    atomic_fetch_sub_explicit(&stripe->count, 1, memory_order_relaxed);
+    return item;
+}
+
+// prints items of the stack based on given PrintFunc, from top to bottom
+void cs_print(ConcurrentStack cs)
+{
+    // check if a PrintFunc exists and if stack isn't empty
+    if (cs->Print == NULL || cs_is_empty(cs)) return;
+    for (uint32_t index = get_index(atomic_load(&cs->top.head)); index != 0; index = atomic_load(&get_node(index, cs)->next)){
+        cs->Print(get_node(index, cs)->data);
+    }
+    printf("\n");
+}
+
+// destroys the given stack
+void cs_destroy(ConcurrentStack cs)
+{
+    if (cs->Destroy != NULL){
+        for (uint32_t index = get_index(atomic_load(&cs->top.head)); index != 0; index = atomic_load(&get_node(index, cs)->next)){
+            cs->Destroy(get_node(index, cs)->data);
+        }
+    }
+    for (int i = 0; i < MAX_CHUNKS; i++) free(atomic_load(&cs->chunks[i]));
+    free(cs);
+}
+
+// returns the number of elements in the stack
+size_t cs_size(ConcurrentStack cs)
+{
+    long size = 0;
+    for (int i = 0; i < SIZE_STRIPES; i++) size += atomic_load_explicit(&cs->size[i].count, memory_order_relaxed);
+    // while items are pushed and popped by other threads, the sum may be momentarily negative
+    return size > 0 ? size : 0;
+}
+
+// returns true/false depending on if stack is empty or not
+bool cs_is_empty(ConcurrentStack cs)
+{
+    if (!cs_size(cs)) return true;
+    else return false;
+}
+
+// sets as new DestroyFunc of given stack the given one
+void cs_set_destroy(ConcurrentStack cs, DestroyFunc destroy)
+{
+    cs->Destroy = destroy;
+}
+
+// sets as new PrintFunc of given stack the given one
+void cs_set_print(ConcurrentStack cs, PrintFunc print)
+{
+    cs->Print = print;
+}
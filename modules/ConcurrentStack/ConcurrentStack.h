@@ -0,0 +1,56 @@
+/* Interface file of (lock-free) Concurrent Stack ADT */
+
+#ifndef CONCURRENT_STACK_H
+#define CONCURRENT_STACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to function printing stack's item
+typedef void (*PrintFunc)(Pointer);
+
+// pointer to concurrent stack
+typedef struct concurrent_stack *ConcurrentStack;
+
+/*-----Functions Provided-----*/
+/* cs_push, cs_push_many, cs_pop, cs_size and cs_is_empty can be called by many threads at the same time
+   on the same stack, without any locks. The other functions need exclusive access.                    */
+
+// initializes an empty concurrent stack
+void cs_initialize(ConcurrentStack *, DestroyFunc, PrintFunc);
+
+// pushes given item on top of the stack
+void cs_push(Pointer, ConcurrentStack);
+
+// pushes the n given items on top of the stack at once, so that the last one ends up on top
+// (the items are never found apart by other threads; they are added with a single compare-and-swap)
+void cs_push_many(Pointer *items, size_t n, ConcurrentStack);
+
+// removes the top item of the stack and returns it, or NULL if the stack is empty
+Pointer cs_pop(ConcurrentStack);
+
+// prints items of the stack, from top to bottom
+void cs_print(ConcurrentStack);
+
+// destroys the given stack, along with its items
+void cs_destroy(ConcurrentStack);
+
+// returns the number of elements in the stack
+size_t cs_size(ConcurrentStack);
+
+// returns true/false depending on if stack is empty or not
+bool cs_is_empty(ConcurrentStack);
+
+// sets as new DestroyFunc of given stack the given one
+void cs_set_destroy(ConcurrentStack, DestroyFunc);
+
+// sets as new PrintFunc of given stack the given one
+void cs_set_print(ConcurrentStack, PrintFunc);
+
+#endif
@@ -13,16 +13,22 @@ typedef struct deque_node{
 struct deque{
     deque_node *front; // pointer to the first/front deque element
     deque_node *rear; // pointer to the last/rear deque element
-    int size; // number of elements in the deque
+    size_t size; // number of elements in the deque
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
     DestroyFunc Destroy;
     PrintFunc Print;
 };
 
-// returns a new deque node with given item as data
-static deque_node *new_deque_node(Pointer item)
+// returns a new deque node with given item as data, that is about to be inserted in given deque
+static deque_node *new_deque_node(Pointer item, Deque dq)
 {
     deque_node *new_node = malloc(sizeof(deque_node));
     assert(new_node);
+    STATS_INC(dq, allocations);
+    STATS_INC(dq, inserts);
+    STATS_MAX(dq, peak_size, dq->size + 1);
     new_node->data = item;
     new_node->next = NULL;
     return new_node;
@@ -46,6 +52,7 @@ void deque_initialize(Deque *dq, DestroyFunc destroy_func, PrintFunc print_func)
     (*dq)->front = NULL;
     (*dq)->rear = NULL;
     (*dq)->size = 0;
+    deque_reset_stats(*dq);
     deque_set_destroy(*dq, destroy_func);
     deque_set_print(*dq, print_func);
 }
@@ -53,7 +60,7 @@ void deque_initialize(Deque *dq, DestroyFunc destroy_func, PrintFunc print_func)
 // inserts a new item at the back/end of the deque
 void deque_insert_back(Pointer item, Deque dq)
 {
-    deque_node *new_node = new_deque_node(item);
+    deque_node *new_node = new_deque_node(item, dq);
     // check if deque is empty
     if (deque_is_empty(dq)){
         insert_first_node(new_node, dq);
@@ -67,7 +74,7 @@ void deque_insert_back(Pointer item, Deque dq)
 // inserts a new item at the front/start of the deque
 void deque_insert_front(Pointer item, Deque dq)
 {
-    deque_node *new_node = new_deque_node(item);
+    deque_node *new_node = new_deque_node(item, dq);
     // check if deque is empty
     if (deque_is_empty(dq)){
         insert_first_node(new_node, dq);
@@ -94,6 +101,8 @@ Pointer deque_remove_back(Deque dq)
     }
     free(dq->rear);
     dq->size--;
+    STATS_INC(dq, frees);
+    STATS_INC(dq, removes);
     dq->rear = new_rear;
     new_rear->next = NULL;
     return item;
@@ -110,10 +119,82 @@ Pointer deque_remove_front(Deque dq)
     deque_node *new_front = dq->front->next;
     free(dq->front);
     dq->size--;
+    STATS_INC(dq, frees);
+    STATS_INC(dq, removes);
     dq->front = new_front;
     return item;
 }
 
+// moves all items of deque src to the back of deque dst, in O(1) without allocating any nodes
+// src is left empty
+void deque_concat(Deque dst, Deque src)
+{
+    if (dst == src || deque_is_empty(src)) return;
+    if (deque_is_empty(dst)) dst->front = src->front;
+    else dst->rear->next = src->front;
+    dst->rear = src->rear;
+    dst->size += src->size;
+    STATS_ADD(dst, inserts, src->size);
+    STATS_ADD(src, removes, src->size);
+    STATS_MAX(dst, peak_size, dst->size);
+    src->front = NULL;
+    src->rear = NULL;
+    src->size = 0;
+}
+
+// splits the deque at given index: the items from that index to the back are moved to a new deque, stored in back,
+// that has the same Destroy and Print functions (it's empty if index >= size), while the first index items stay in dq
+// O(index), since the nodes before the split have to be walked, without allocating any nodes
+void deque_split_at(size_t index, Deque dq, Deque *back)
+{
+    deque_initialize(back, dq->Destroy, dq->Print);
+    if (index >= deque_size(dq)) return;
+    size_t moved = dq->size - index;
+    (*back)->rear = dq->rear;
+    (*back)->size = moved;
+    if (index == 0){
+        (*back)->front = dq->front;
+        dq->front = NULL;
+        dq->rear = NULL;
+    }
+    else{
+        // find the last node that stays in dq
+        deque_node *last = dq->front;
+        for (size_t i = 1; i < index; i++) last = last->next;
+        (*back)->front = last->next;
+        dq->rear = last;
+        last->next = NULL;
+    }
+    dq->size = index;
+    STATS_ADD(dq, removes, moved);
+    STATS_ADD(*back, inserts, moved);
+    STATS_MAX(*back, peak_size, moved);
+}
+
+// visits the items of the deque from the front to the back with given VisitFunc, until a visit returns false
+void deque_for_each(Deque dq, VisitFunc visit, void *context)
+{
+    if (deque_is_empty(dq)) return;
+    for (deque_node *node = dq->front; node != NULL; node = node->next){
+        if (!visit(node->data, context)) return;
+    }
+}
+
+// initializes given iterator at the front of the deque
+void deque_iterator_init(DequeIterator *it, Deque dq)
+{
+    it->node = deque_is_empty(dq) ? NULL : dq->front;
+}
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer deque_iterator_next(DequeIterator *it)
+{
+    if (it->node == NULL) return NULL;
+    Pointer item = it->node->data;
+    it->node = it->node->next;
+    return item;
+}
+
 // prints items of the deque based on given PrintFunc
 void deque_print(Deque dq)
 {
@@ -149,7 +230,7 @@ void deque_destroy(Deque dq)
 }
 
 // returns the number of elements in the deque
-int deque_size(Deque dq)
+size_t deque_size(Deque dq)
 {
     return dq->size;
 }
@@ -177,6 +258,27 @@ Pointer deque_rear(Deque dq)
     return dq->rear->data;
 }
 
+// returns the operation counters of the deque
+AdtStats deque_get_stats(Deque dq)
+{
+#ifdef ADT_STATS
+    return dq->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the deque; the peak size becomes the current size
+void deque_reset_stats(Deque dq)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = dq->size;
+    dq->stats = stats;
+#endif
+}
+
 // sets as new DestroyFunc of given deque the given one
 void deque_set_destroy(Deque dq, DestroyFunc destroy_func)
 {
@@ -4,6 +4,9 @@
 #define DEQUE_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+#include "../Iterators/Iterators.h"
 
 // generic-pointer typedef
 typedef void *Pointer;
@@ -14,9 +17,16 @@ typedef void (*DestroyFunc)(Pointer);
 // pointer to function printing deque's item
 typedef void (*PrintFunc)(Pointer);
 
+// pointer to function that visits given element, with the context given to the visiting function
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
 // pointer to deque
 typedef struct deque *Deque;
 
+// iterator over the items of a deque (DequeIterator, defined in Iterators.h), from the front to the back
+// declared by the user (usually as a local variable); it stays valid as long as the deque isn't changed
+
 /*-----Functions Provided-----*/
 
 // initializes an empty deque
@@ -36,6 +46,23 @@ Pointer deque_remove_back(Deque);
 // returns NULL if deque is empty
 Pointer deque_remove_front(Deque);
 
+// moves all items of src to the back of dst in O(1); src is left empty
+void deque_concat(Deque dst, Deque src);
+
+// moves the items from given index to the back of the deque to a new deque, stored in back, in O(index)
+// the first index items stay in the deque
+void deque_split_at(size_t index, Deque, Deque *back);
+
+// visits the items of the deque from the front to the back with given VisitFunc and context
+// stops once a visit returns false
+void deque_for_each(Deque, VisitFunc, void *context);
+
+// initializes given iterator at the front of the deque
+void deque_iterator_init(DequeIterator *, Deque);
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer deque_iterator_next(DequeIterator *);
+
 // prints items of the deque
 void deque_print(Deque);
 
@@ -43,7 +70,7 @@ void deque_print(Deque);
 void deque_destroy(Deque);
 
 // returns the number of elements in the deque
-int deque_size(Deque);
+size_t deque_size(Deque);
 
 // returns true/false depending on if deque is empty or not
 bool deque_is_empty(Deque);
@@ -54,6 +81,12 @@ Pointer deque_front(Deque);
 // returns the element at the end of the deque
 Pointer deque_rear(Deque);
 
+// returns the operation counters of the deque (see Stats.h)
+AdtStats deque_get_stats(Deque);
+
+// resets the operation counters of the deque
+void deque_reset_stats(Deque);
+
 // sets as new DestroyFunc of given deque the given one
 void deque_set_destroy(Deque, DestroyFunc);
 
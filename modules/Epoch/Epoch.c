@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <assert.h>
+#include "Epoch.h"
+
+// bit of a thread's state that is set while the thread is in a critical section
+#define ACTIVE 1UL
+
+// number of items a thread retires between two collections
+#define COLLECT_THRESHOLD 64
+
+// number of limbo lists of a thread; the items of an epoch are safe two epochs later, so three lists are enough
+#define LIMBO_LISTS 3
+
+// retired item, waiting to be destroyed
+typedef struct retired_item{
+    Pointer data; // pointer to the item
+    DestroyFunc Destroy; // function that destroys the item
+}retired_item;
+
+// list of the items retired by a thread in the same epoch
+typedef struct limbo_list{
+    retired_item *items; // dynamic array of the retired items
+    size_t count; // number of retired items
+    size_t capacity; // size of the array
+    unsigned long epoch; // epoch the items were retired in
+}limbo_list;
+
+// thread record struct
+typedef struct ep_thread{
+    atomic_ulong state; // (epoch << 1) | ACTIVE while the thread is in a critical section, else 0
+    atomic_bool in_use; // true while a thread is registered with the record
+    atomic_size_t pending; // number of items in the limbo lists
+    int nesting; // depth of nested critical sections
+    int retires; // number of items retired since the last collection
+    limbo_list limbo[LIMBO_LISTS]; // items retired in the last epochs, indexed by epoch % LIMBO_LISTS
+    struct ep_thread *next; // pointer to the next record of the domain
+}ep_thread;
+
+// epoch domain struct
+/* Epoch-based reclamation (Fraser): the domain has a global epoch, and a thread entering a critical section
+   announces the epoch it read. The global epoch moves from e to e + 1 only once every thread in a critical
+   section has announced e, so when it reaches e + 2, every critical section that was running in epoch e
+   (and could have seen the items retired in it) is over. Every thread keeps the items it retires in a limbo
+   list per epoch, and destroys them two epochs later. Threads are registered with a record, found through a
+   pthread key of the domain; records are never freed before the domain, and a thread that exits releases its
+   record (with the items still in it) for the next registered thread.                                       */
+struct epoch_domain{
+    atomic_ulong epoch; // the global epoch
+    _Atomic(ep_thread *) threads; // list of the thread records
+    pthread_key_t key; // thread-specific pointer to the record of every registered thread
+};
+
+// limbo list functions
+
+// destroys the items of given limbo list and empties it
+// returns the number of destroyed items
+static size_t reclaim_list(limbo_list *list, ep_thread *thread)
+{
+    size_t count = list->count;
+    for (size_t i = 0; i < count; i++){
+        if (list->items[i].Destroy != NULL) list->items[i].Destroy(list->items[i].data);
+    }
+    list->count = 0;
+    atomic_fetch_sub_explicit(&thread->pending, count, memory_order_relaxed);
+    return count;
+}
+
+// appends given item to given limbo list
+static void append_item(limbo_list *list, Pointer item, DestroyFunc destroy)
+{
+    if (list->count == list->capacity){
+        list->capacity = list->capacity ? 2 * list->capacity : COLLECT_THRESHOLD;
+        list->items = realloc(list->items, list->capacity * sizeof(retired_item));
+        assert(list->items);
+    }
+    list->items[list->count].data = item;
+    list->items[list->count].Destroy = destroy;
+    list->count++;
+}
+
+// thread record functions
+
+// releases the record of an exiting or unregistered thread
+static void release_thread(void *record)
+{
+    ep_thread *thread = record;
+    thread->nesting = 0;
+    atomic_store(&thread->state, 0);
+    atomic_store(&thread->in_use, false);
+}
+
+// returns the record of the calling thread, registering the thread if needed
+static ep_thread *get_thread(EpochDomain ed)
+{
+    ep_thread *thread = pthread_getspecific(ed->key);
+    if (thread != NULL) return thread;
+    // reuse the record of a thread that is gone, if any
+    for (thread = atomic_load(&ed->threads); thread != NULL; thread = thread->next){
+        bool in_use = false;
+        if (!atomic_load(&thread->in_use) && atomic_compare_exchange_strong(&thread->in_use, &in_use, true)) break;
+    }
+    if (thread == NULL){
+        thread = malloc(sizeof(ep_thread));
+        assert(thread);
+        atomic_init(&thread->state, 0);
+        atomic_init(&thread->in_use, true);
+        atomic_init(&thread->pending, 0);
+        thread->nesting = 0;
+        thread->retires = 0;
+        for (int i = 0; i < LIMBO_LISTS; i++){
+            thread->limbo[i].items = NULL;
+            thread->limbo[i].count = 0;
+            thread->limbo[i].capacity = 0;
+            thread->limbo[i].epoch = 0;
+        }
+        thread->next = atomic_load(&ed->threads);
+        while (!atomic_compare_exchange_weak(&ed->threads, &thread->next, thread));
+    }
+    pthread_setspecific(ed->key, thread);
+    return thread;
+}
+
+// advances the global epoch if every thread in a critical section has announced it
+// returns the global epoch
+static unsigned long try_advance(EpochDomain ed)
+{
+    unsigned long epoch = atomic_load(&ed->epoch);
+    for (ep_thread *thread = atomic_load(&ed->threads); thread != NULL; thread = thread->next){
+        unsigned long state = atomic_load(&thread->state);
+        if ((state & ACTIVE) && state >> 1 != epoch) return epoch;
+    }
+    // if another thread advanced it meanwhile, epoch is updated to the new one
+    if (atomic_compare_exchange_strong(&ed->epoch, &epoch, epoch + 1)) epoch++;
+    return epoch;
+}
+
+// Epoch ADT functions
+
+// initializes an epoch domain
+// returns false if no pthread key is left for it; *ed is then NULL
+bool ep_initialize(EpochDomain *ed)
+{
+    *ed = malloc(sizeof(struct epoch_domain));
+    assert(*ed);
+    if (pthread_key_create(&(*ed)->key, release_thread)){
+        free(*ed);
+        *ed = NULL;
+        return false;
+    }
+    atomic_init(&(*ed)->epoch, 0);
+    atomic_init(&(*ed)->threads, NULL);
+    return true;
+}
+
+// registers the calling thread with the domain
+void ep_register(EpochDomain ed)
+{
+    get_thread(ed);
+}
+
+// unregisters the calling thread from the domain
+void ep_unregister(EpochDomain ed)
+{
+    ep_thread *thread = pthread_getspecific(ed->key);
+    if (thread == NULL) return;
+    pthread_setspecific(ed->key, NULL);
+    release_thread(thread);
+}
+
+// starts a critical section of the calling thread
+void ep_enter(EpochDomain ed)
+{
+    ep_thread *thread = get_thread(ed);
+    if (thread->nesting++) return;
+    // the announcement is sequentially consistent, so the reads of the critical section can't move before it
+    atomic_store(&thread->state, atomic_load(&ed->epoch) << 1 | ACTIVE);
+}
+
+// ends a critical section of the calling thread
+void ep_exit(EpochDomain ed)
+{
+    ep_thread *thread = pthread_getspecific(ed->key);
+    assert(thread != NULL && thread->nesting > 0);
+    if (--thread->nesting) return;
+    atomic_store_explicit(&thread->state, 0, memory_order_release);
+}
+
+// retires given item, which is passed to given DestroyFunc once it's safe
+void ep_retire(Pointer item, DestroyFunc destroy, EpochDomain ed)
+{
+    ep_thread *thread = get_thread(ed);
+    unsigned long epoch = atomic_load(&ed->epoch);
+    limbo_list *list = &thread->limbo[epoch % LIMBO_LISTS];
+    // a list of an older epoch is at least LIMBO_LISTS epochs old, so its items are safe
+    if (list->epoch != epoch){
+        reclaim_list(list, thread);
+        list->epoch = epoch;
+    }
+    append_item(list, item, destroy);
+    atomic_fetch_add_explicit(&thread->pending, 1, memory_order_relaxed);
+    if (++thread->retires >= COLLECT_THRESHOLD) ep_collect(ed);
+}
+
+// advances the epoch of the domain if possible, and destroys the safe items retired by the calling thread
+size_t ep_collect(EpochDomain ed)
+{
+    ep_thread *thread = get_thread(ed);
+    thread->retires = 0;
+    unsigned long epoch = try_advance(ed);
+    size_t reclaimed = 0;
+    for (int i = 0; i < LIMBO_LISTS; i++){
+        limbo_list *list = &thread->limbo[i];
+        if (list->count && list->epoch + 2 <= epoch) reclaimed += reclaim_list(list, thread);
+    }
+    return reclaimed;
+}
+
+// returns the number of retired items of the domain that haven't been destroyed yet
+size_t ep_pending(EpochDomain ed)
+{
+    size_t pending = 0;
+    for (ep_thread *thread = atomic_load(&ed->threads); thread != NULL; thread = thread->next){
+        pending += atomic_load_explicit(&thread->pending, memory_order_relaxed);
+    }
+    return pending;
+}
+
+// destroys the given domain, along with all the items retired to it
+void ep_destroy(EpochDomain ed)
+{
+    ep_thread *thread = atomic_load(&ed->threads);
+    while (thread != NULL){
+        ep_thread *next = thread->next;
+        for (int i = 0; i < LIMBO_LISTS; i++){
+            reclaim_list(&thread->limbo[i], thread);
+            free(thread->limbo[i].items);
+        }
+        free(thread);
+        thread = next;
+    }
+    pthread_key_delete(ed->key);
+    free(ed);
+}
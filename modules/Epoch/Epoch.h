@@ -0,0 +1,61 @@
+/* Interface file of Epoch (epoch-based memory reclamation) ADT */
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to epoch domain
+typedef struct epoch_domain *EpochDomain;
+
+/*-----Functions Provided-----*/
+/* A lock-free container unlinks a node while other threads may still be reading it, so the node can't be freed
+   right away. Readers of a domain wrap every access in ep_enter/ep_exit (a critical section), and removers pass the
+   unlinked nodes (or items) to ep_retire, which destroys them once every critical section that might have seen them
+   is over. All functions except ep_initialize and ep_destroy can be called by many threads at the same time.
+   Every domain uses a pthread key, so there can be up to PTHREAD_KEYS_MAX (usually 1024, shared with the rest of the
+   program) domains at the same time. Many containers can share one domain (see sl_initialize_shared, rmt_initialize_shared). */
+
+// initializes an epoch domain
+// returns false if no pthread key is left for the domain (see PTHREAD_KEYS_MAX); the domain is then NULL
+bool ep_initialize(EpochDomain *);
+
+// registers the calling thread with the domain
+// (optional; ep_enter and ep_retire register the calling thread the first time they are called)
+void ep_register(EpochDomain);
+
+// unregisters the calling thread from the domain, which must not be in a critical section of it
+// (optional; threads are unregistered when they exit). The items it retired are reclaimed later
+void ep_unregister(EpochDomain);
+
+// starts a critical section of the calling thread: nothing retired from now on is destroyed until it ends
+// critical sections can be nested; only the outermost ep_exit ends them
+void ep_enter(EpochDomain);
+
+// ends a critical section of the calling thread
+void ep_exit(EpochDomain);
+
+// retires given item, which must be unreachable for threads that enter a critical section from now on
+// the item is passed to given DestroyFunc once the critical sections that started before are over
+void ep_retire(Pointer, DestroyFunc, EpochDomain);
+
+// advances the epoch of the domain if possible, and destroys the items retired by the calling thread that are safe
+// (ep_retire calls it every few retired items; it's not needed otherwise)
+// returns the number of destroyed items
+size_t ep_collect(EpochDomain);
+
+// returns the number of retired items of the domain that haven't been destroyed yet
+size_t ep_pending(EpochDomain);
+
+// destroys the given domain, along with all the items retired to it
+// no thread can be in a critical section of the domain
+void ep_destroy(EpochDomain);
+
+#endif
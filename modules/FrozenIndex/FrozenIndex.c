@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "FrozenIndex.h"
+
+// size of a cache line; the items' array is aligned to it
+#define CACHE_LINE 64
+
+// number of items that fit in a cache line
+#define ITEMS_PER_LINE (CACHE_LINE / sizeof(Pointer))
+
+#ifdef __GNUC__
+#define PREFETCH(address) __builtin_prefetch(address)
+#define FIND_FIRST_SET(x) __builtin_ffsl((long)(x))
+#else
+#define PREFETCH(address) ((void)(address))
+// returns one plus the index of the least significant set bit of x (0 if x is 0)
+static int FIND_FIRST_SET(size_t x)
+{
+    if (!x) return 0;
+    int bit = 1;
+    while (!(x & 1)){
+        x >>= 1;
+        bit++;
+    }
+    return bit;
+}
+#endif
+
+// frozen index struct
+/* The items are stored in Eytzinger (BFS) order in one contiguous array: items[1] is the root and the
+   children of items[k] are items[2k] and items[2k+1]. A search visits the same nodes as a search in a
+   perfectly balanced bst, but the first levels share a few cache lines and the descendants of each node
+   a few levels down are next to each other, so they can be prefetched while the comparisons run. */
+struct frozen_index{
+    Pointer *items; // array of the items in Eytzinger order (1-indexed; items[0] is unused)
+    size_t size; // number of elements in the frozen index
+    CompareFunc Compare;
+    DestroyFunc Destroy;
+    PrintFunc Print;
+};
+
+// Eytzinger layout functions
+
+// places the sorted items, starting from sorted[i], in the subtree of index k
+// returns the index of the first sorted item that wasn't placed
+static size_t fill_eytzinger(Pointer *items, size_t n, Pointer *sorted, size_t i, size_t k)
+{
+    if (k > n) return i;
+    i = fill_eytzinger(items, n, sorted, i, 2 * k);
+    items[k] = sorted[i++];
+    return fill_eytzinger(items, n, sorted, i, 2 * k + 1);
+}
+
+// returns the index of the smallest item that is not less than given item, or 0 if there is none
+static size_t lower_bound_index(Pointer item, FrozenIndex fi)
+{
+    size_t k = 1;
+    while (k <= fi->size){
+        // prefetch the descendants of k a few levels down, which share a cache line
+        PREFETCH(fi->items + ITEMS_PER_LINE * k);
+        // go right if items[k] < item, without branching on the result
+        k = 2 * k + (fi->Compare(fi->items[k], item) < 0);
+    }
+    // the answer is the last node where the search went left; drop the trailing right turns and that left turn
+    return k >> FIND_FIRST_SET(~k);
+}
+
+// prints the items of the subtree of index k in-order
+static void print_items(FrozenIndex fi, size_t k)
+{
+    if (k > fi->size) return;
+    print_items(fi, 2 * k);
+    fi->Print(fi->items[k]);
+    print_items(fi, 2 * k + 1);
+}
+
+// Frozen Index ADT functions
+
+// initializes a frozen index holding the n sorted items of given array
+void fi_initialize_from_sorted(FrozenIndex *fi, Pointer *items, size_t n, CompareFunc compare_func, DestroyFunc destroy_func, PrintFunc print_func)
+{
+    *fi = malloc(sizeof(struct frozen_index));
+    assert(*fi);
+    // round the array size up to whole cache lines, as required by aligned_alloc
+    size_t bytes = (n + 1) * sizeof(Pointer);
+    bytes = (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+    (*fi)->items = aligned_alloc(CACHE_LINE, bytes);
+    assert((*fi)->items);
+    (*fi)->items[0] = NULL;
+    fill_eytzinger((*fi)->items, n, items, 0, 1);
+    (*fi)->size = n;
+    (*fi)->Compare = compare_func;
+    fi_set_destroy(*fi, destroy_func);
+    fi_set_print(*fi, print_func);
+}
+
+// returns true/false based on if given item is found in the frozen index or not
+bool fi_search(Pointer item, FrozenIndex fi)
+{
+    return fi_find(item, fi) != NULL ? true : false;
+}
+
+// returns the item of the frozen index that is equal to given item, or NULL if not found
+Pointer fi_find(Pointer item, FrozenIndex fi)
+{
+    size_t k = lower_bound_index(item, fi);
+    if (k && !fi->Compare(fi->items[k], item)) return fi->items[k];
+    return NULL;
+}
+
+// returns the smallest item that is not less than given item, or NULL if there is none
+Pointer fi_lower_bound(Pointer item, FrozenIndex fi)
+{
+    return fi->items[lower_bound_index(item, fi)];
+}
+
+// returns the smallest/element with min key of the frozen index
+Pointer fi_min(FrozenIndex fi)
+{
+    if (fi_is_empty(fi)) return NULL;
+    size_t k = 1;
+    while (2 * k <= fi->size) k = 2 * k;
+    return fi->items[k];
+}
+
+// returns the largest/element with max key of the frozen index
+Pointer fi_max(FrozenIndex fi)
+{
+    if (fi_is_empty(fi)) return NULL;
+    size_t k = 1;
+    while (2 * k + 1 <= fi->size) k = 2 * k + 1;
+    return fi->items[k];
+}
+
+// prints items of the frozen index in ascending order, based on given PrintFunc
+void fi_print(FrozenIndex fi)
+{
+    if (fi->Print == NULL || fi_is_empty(fi)) return;
+    print_items(fi, 1);
+    printf("\n");
+}
+
+// destroys the given frozen index
+void fi_destroy(FrozenIndex fi)
+{
+    if (fi->Destroy != NULL){
+        for (size_t k = 1; k <= fi->size; k++) fi->Destroy(fi->items[k]);
+    }
+    free(fi->items);
+    free(fi);
+}
+
+// returns the number of elements in the frozen index
+size_t fi_size(FrozenIndex fi)
+{
+    return fi->size;
+}
+
+// returns true/false depending on if frozen index is empty or not
+bool fi_is_empty(FrozenIndex fi)
+{
+    if (!fi_size(fi)) return true;
+    else return false;
+}
+
+// sets as new DestroyFunc of given frozen index the given one
+void fi_set_destroy(FrozenIndex fi, DestroyFunc destroy_func)
+{
+    fi->Destroy = destroy_func;
+}
+
+// sets as new PrintFunc of given frozen index the given one
+void fi_set_print(FrozenIndex fi, PrintFunc print_func)
+{
+    fi->Print = print_func;
+}
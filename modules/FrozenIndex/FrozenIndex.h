@@ -0,0 +1,69 @@
+/* Interface file of Frozen Index ADT */
+
+#ifndef FROZEN_INDEX_H
+#define FROZEN_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+/* pointer to function that compares two elements a and b. Returns:
+   < 0 if a < b
+   = 0 if a = b (based on given comparison)
+   > 0 if a > b                                                   */
+typedef int (*CompareFunc)(Pointer a, Pointer b);
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to function printing frozen index's item
+typedef void (*PrintFunc)(Pointer);
+
+// pointer to frozen index
+typedef struct frozen_index *FrozenIndex;
+
+/*-----Functions Provided-----*/
+
+// initializes a read-only frozen index holding the n items of given array
+// the items must be sorted in ascending order (based on given CompareFunc) and distinct
+// (a red black tree can also be turned into a frozen index with red_black_freeze)
+void fi_initialize_from_sorted(FrozenIndex *, Pointer *items, size_t n, CompareFunc, DestroyFunc, PrintFunc);
+
+// returns true/false based on if given item is found in the frozen index or not
+bool fi_search(Pointer, FrozenIndex);
+
+// returns the item of the frozen index that is equal to given item
+// returns NULL if not found
+Pointer fi_find(Pointer, FrozenIndex);
+
+// returns the smallest item of the frozen index that is not less than given item
+// returns NULL if all items are less than given item
+Pointer fi_lower_bound(Pointer, FrozenIndex);
+
+// returns the element with lowest value
+Pointer fi_min(FrozenIndex);
+
+// returns the element with highest value
+Pointer fi_max(FrozenIndex);
+
+// prints items of the frozen index in ascending order
+void fi_print(FrozenIndex);
+
+// destroys the given frozen index
+void fi_destroy(FrozenIndex);
+
+// returns the number of elements in the frozen index
+size_t fi_size(FrozenIndex);
+
+// returns true/false depending on if frozen index is empty or not
+bool fi_is_empty(FrozenIndex);
+
+// sets as new DestroyFunc of given frozen index the given one
+void fi_set_destroy(FrozenIndex, DestroyFunc);
+
+// sets as new PrintFunc of given frozen index the given one
+void fi_set_print(FrozenIndex, PrintFunc);
+
+#endif
@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "IntrusiveList.h"
+
+// intrusive list struct
+/* The links are kept in a circular doubly-linked list with a dummy head link, so every insertion and removal
+   is O(1) without any special cases. The list never allocates anything for its links: they are embedded in
+   the user's structs, and an unlinked link has NULL next and prev pointers.                          */
+struct intrusive_list{
+    struct adt_list_link head; // dummy head link; head.next is the front and head.prev the back of the list
+    size_t size; // number of links in the list
+    ListLinkFunc Destroy;
+    ListLinkFunc Print;
+};
+
+// link functions
+
+// links given link between prev and next
+static void link_between(struct adt_list_link *link, struct adt_list_link *prev, struct adt_list_link *next)
+{
+    link->prev = prev;
+    link->next = next;
+    prev->next = link;
+    next->prev = link;
+}
+
+// unlinks given link from its neighbours
+static void unlink_link(struct adt_list_link *link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->next = NULL;
+    link->prev = NULL;
+}
+
+// Intrusive List ADT functions
+
+// initializes an empty intrusive list
+void ilist_initialize(IntrusiveList *list, ListLinkFunc destroy_func, ListLinkFunc print_func)
+{
+    *list = malloc(sizeof(struct intrusive_list));
+    assert(*list);
+    (*list)->head.next = &(*list)->head;
+    (*list)->head.prev = &(*list)->head;
+    (*list)->size = 0;
+    ilist_set_destroy(*list, destroy_func);
+    ilist_set_print(*list, print_func);
+}
+
+// links given link at the back/end of the list
+void ilist_insert_back(struct adt_list_link *link, IntrusiveList list)
+{
+    link_between(link, list->head.prev, &list->head);
+    list->size++;
+}
+
+// links given link at the front/start of the list
+void ilist_insert_front(struct adt_list_link *link, IntrusiveList list)
+{
+    link_between(link, &list->head, list->head.next);
+    list->size++;
+}
+
+// links given link right after the link pos of the list
+void ilist_insert_after(struct adt_list_link *link, struct adt_list_link *pos, IntrusiveList list)
+{
+    link_between(link, pos, pos->next);
+    list->size++;
+}
+
+// unlinks and returns the link at the front of the list
+// returns NULL if list is empty
+struct adt_list_link *ilist_remove_front(IntrusiveList list)
+{
+    if (ilist_is_empty(list)) return NULL;
+    struct adt_list_link *link = list->head.next;
+    ilist_remove(link, list);
+    return link;
+}
+
+// unlinks and returns the link at the back of the list
+// returns NULL if list is empty
+struct adt_list_link *ilist_remove_back(IntrusiveList list)
+{
+    if (ilist_is_empty(list)) return NULL;
+    struct adt_list_link *link = list->head.prev;
+    ilist_remove(link, list);
+    return link;
+}
+
+// unlinks given link from the list
+void ilist_remove(struct adt_list_link *link, IntrusiveList list)
+{
+    unlink_link(link);
+    list->size--;
+}
+
+// moves the front link to the back of the list
+void ilist_rotate(IntrusiveList list)
+{
+    if (ilist_size(list) < 2) return;
+    struct adt_list_link *link = list->head.next;
+    unlink_link(link);
+    link_between(link, list->head.prev, &list->head);
+}
+
+// moves all links of src to the back of dst in O(1); src is left empty
+void ilist_concat(IntrusiveList dst, IntrusiveList src)
+{
+    if (dst == src || ilist_is_empty(src)) return;
+    // the chain of src's links is placed between the back of dst and its head
+    struct adt_list_link *first = src->head.next, *last = src->head.prev;
+    first->prev = dst->head.prev;
+    dst->head.prev->next = first;
+    last->next = &dst->head;
+    dst->head.prev = last;
+    dst->size += src->size;
+    src->head.next = &src->head;
+    src->head.prev = &src->head;
+    src->size = 0;
+}
+
+// returns the link after given link of the list, or NULL if it's the last one
+struct adt_list_link *ilist_next(struct adt_list_link *link, IntrusiveList list)
+{
+    return link->next != &list->head ? link->next : NULL;
+}
+
+// returns the link before given link of the list, or NULL if it's the first one
+struct adt_list_link *ilist_prev(struct adt_list_link *link, IntrusiveList list)
+{
+    return link->prev != &list->head ? link->prev : NULL;
+}
+
+// returns true/false depending on if given link is in a list or not
+// (a link that was never inserted must be zeroed for this to work)
+bool ilist_is_linked(struct adt_list_link *link)
+{
+    if (link->next != NULL) return true;
+    else return false;
+}
+
+// prints the structs of the list based on the print function, from the front to the back
+void ilist_print(IntrusiveList list)
+{
+    // check if a print function exists and list isn't empty
+    if (list->Print == NULL || ilist_is_empty(list)) return;
+    for (struct adt_list_link *link = list->head.next; link != &list->head; link = link->next) list->Print(link);
+    printf("\n");
+}
+
+// destroys the given intrusive list
+void ilist_destroy(IntrusiveList list)
+{
+    struct adt_list_link *link = list->head.next;
+    while (link != &list->head){
+        // the link is unlinked before its struct is destroyed, which may free it
+        struct adt_list_link *next = link->next;
+        link->next = NULL;
+        link->prev = NULL;
+        if (list->Destroy != NULL) list->Destroy(link);
+        link = next;
+    }
+    free(list);
+}
+
+// returns the number of links in the list
+size_t ilist_size(IntrusiveList list)
+{
+    return list->size;
+}
+
+// returns true/false depending on if list is empty or not
+bool ilist_is_empty(IntrusiveList list)
+{
+    if (!ilist_size(list)) return true;
+    else return false;
+}
+
+// returns the link at the front of the list, or NULL if list is empty
+struct adt_list_link *ilist_front(IntrusiveList list)
+{
+    if (ilist_is_empty(list)) return NULL;
+    return list->head.next;
+}
+
+// returns the link at the back of the list, or NULL if list is empty
+struct adt_list_link *ilist_back(IntrusiveList list)
+{
+    if (ilist_is_empty(list)) return NULL;
+    return list->head.prev;
+}
+
+// sets as new destroy function of given list the given one
+void ilist_set_destroy(IntrusiveList list, ListLinkFunc destroy_func)
+{
+    list->Destroy = destroy_func;
+}
+
+// sets as new print function of given list the given one
+void ilist_set_print(IntrusiveList list, ListLinkFunc print_func)
+{
+    list->Print = print_func;
+}
@@ -0,0 +1,78 @@
+/* Interface file of Intrusive List ADT */
+
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// the list link (struct adt_list_link), embedded in the user's struct, and ADT_CONTAINER_OF
+#include "../Links/Links.h"
+
+// pointer to function that destroys or prints the struct containing given list link
+typedef void (*ListLinkFunc)(struct adt_list_link *);
+
+// pointer to intrusive list
+typedef struct intrusive_list *IntrusiveList;
+
+/*-----Functions Provided-----*/
+
+// initializes an empty intrusive list
+void ilist_initialize(IntrusiveList *, ListLinkFunc destroy, ListLinkFunc print);
+
+// links given (unlinked) link at the back/end of the list
+void ilist_insert_back(struct adt_list_link *, IntrusiveList);
+
+// links given (unlinked) link at the front/start of the list
+void ilist_insert_front(struct adt_list_link *, IntrusiveList);
+
+// links given (unlinked) link right after the link pos of the list
+void ilist_insert_after(struct adt_list_link *, struct adt_list_link *pos, IntrusiveList);
+
+// unlinks and returns the link at the front of the list
+// returns NULL if list is empty
+struct adt_list_link *ilist_remove_front(IntrusiveList);
+
+// unlinks and returns the link at the back of the list
+// returns NULL if list is empty
+struct adt_list_link *ilist_remove_back(IntrusiveList);
+
+// unlinks given link from the list, in O(1)
+void ilist_remove(struct adt_list_link *, IntrusiveList);
+
+// moves the front link to the back of the list, like advancing the cursor of a circular list
+void ilist_rotate(IntrusiveList);
+
+// moves all links of src to the back of dst in O(1); src is left empty
+void ilist_concat(IntrusiveList dst, IntrusiveList src);
+
+// returns the link after/before given link of the list, or NULL if it's the last/first one
+struct adt_list_link *ilist_next(struct adt_list_link *, IntrusiveList);
+struct adt_list_link *ilist_prev(struct adt_list_link *, IntrusiveList);
+
+// returns true/false depending on if given link is in a list or not
+bool ilist_is_linked(struct adt_list_link *);
+
+// prints the structs of the list, from the front to the back
+void ilist_print(IntrusiveList);
+
+// destroys the given intrusive list, destroying the structs of the links that are still in it
+void ilist_destroy(IntrusiveList);
+
+// returns the number of links in the list
+size_t ilist_size(IntrusiveList);
+
+// returns true/false depending on if list is empty or not
+bool ilist_is_empty(IntrusiveList);
+
+// returns the link at the front/back of the list, or NULL if list is empty
+struct adt_list_link *ilist_front(IntrusiveList);
+struct adt_list_link *ilist_back(IntrusiveList);
+
+// sets as new destroy function of given list the given one
+void ilist_set_destroy(IntrusiveList, ListLinkFunc);
+
+// sets as new print function of given list the given one
+void ilist_set_print(IntrusiveList, ListLinkFunc);
+
+#endif
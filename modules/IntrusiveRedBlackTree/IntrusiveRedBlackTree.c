@@ -0,0 +1,327 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "IntrusiveRedBlackTree.h"
+
+// intrusive red black tree struct
+/* The tree never allocates anything for its links, which are embedded in the user's structs; a removed link
+   is unlinked from its neighbours without any search, since it holds its parent pointer. Missing children are
+   NULL (there is no dummy node, which would have to be shared by all trees), so the deletion fix-up keeps track
+   of the parent of the (possibly NULL) double black link explicitly.                                        */
+struct intrusive_rbt{
+    struct adt_rb_link *root; // pointer to the root link of the tree
+    size_t size; // number of links in the tree
+    LinkCompareFunc Compare;
+    KeyCompareFunc CompareKey;
+    RBLinkFunc Destroy;
+    RBLinkFunc Print;
+};
+
+// link functions
+
+// returns true if given link is red; missing (NULL) links are black
+static bool is_red(struct adt_rb_link *link)
+{
+    return link != NULL && link->red;
+}
+
+// replaces the child old of given parent (or the root, if parent is NULL) with new_child
+static void replace_child(struct adt_rb_link *parent, struct adt_rb_link *old, struct adt_rb_link *new_child, IntrusiveRedBlackTree tree)
+{
+    if (parent == NULL) tree->root = new_child;
+    else if (parent->left == old) parent->left = new_child;
+    else parent->right = new_child;
+    if (new_child != NULL) new_child->parent = parent;
+}
+
+// performs left rotation at head
+static void left_rotation(struct adt_rb_link *head, IntrusiveRedBlackTree tree)
+{
+    struct adt_rb_link *link = head->right;
+    head->right = link->left;
+    if (link->left != NULL) link->left->parent = head;
+    replace_child(head->parent, head, link, tree);
+    link->left = head;
+    head->parent = link;
+}
+
+// performs right rotation at head
+static void right_rotation(struct adt_rb_link *head, IntrusiveRedBlackTree tree)
+{
+    struct adt_rb_link *link = head->left;
+    head->left = link->right;
+    if (link->right != NULL) link->right->parent = head;
+    replace_child(head->parent, head, link, tree);
+    link->right = head;
+    head->parent = link;
+}
+
+// fixes the double-red problem of given (red) link, after its insertion
+static void fix_double_red(struct adt_rb_link *link, IntrusiveRedBlackTree tree)
+{
+    while (is_red(link->parent)){
+        struct adt_rb_link *parent = link->parent, *grandparent = parent->parent;
+        struct adt_rb_link *uncle = grandparent->left == parent ? grandparent->right : grandparent->left;
+        // red uncle; recoloring moves the problem two levels up
+        if (is_red(uncle)){
+            parent->red = false;
+            uncle->red = false;
+            grandparent->red = true;
+            link = grandparent;
+            continue;
+        }
+        // black uncle; restructuring with one or two rotations solves the problem
+        if (grandparent->left == parent){
+            if (parent->right == link){
+                left_rotation(parent, tree);
+                parent = link;
+            }
+            right_rotation(grandparent, tree);
+        }else{
+            if (parent->left == link){
+                right_rotation(parent, tree);
+                parent = link;
+            }
+            left_rotation(grandparent, tree);
+        }
+        parent->red = false;
+        grandparent->red = true;
+        break;
+    }
+    tree->root->red = false;
+}
+
+// fixes the double-black problem of given link (possibly NULL), child of given parent, after a removal
+static void fix_double_black(struct adt_rb_link *link, struct adt_rb_link *parent, IntrusiveRedBlackTree tree)
+{
+    while (link != tree->root && !is_red(link)){
+        bool left = parent->left == link;
+        struct adt_rb_link *sibling = left ? parent->right : parent->left;
+        // red sibling; an adjustment rotation makes the sibling black
+        if (is_red(sibling)){
+            sibling->red = false;
+            parent->red = true;
+            if (left) left_rotation(parent, tree);
+            else right_rotation(parent, tree);
+            sibling = left ? parent->right : parent->left;
+        }
+        // black sibling with black children; recoloring moves the problem one level up
+        if (!is_red(sibling->left) && !is_red(sibling->right)){
+            sibling->red = true;
+            link = parent;
+            parent = link->parent;
+            continue;
+        }
+        // black sibling with a red child; restructuring solves the problem
+        if (left){
+            if (!is_red(sibling->right)){
+                sibling->left->red = false;
+                sibling->red = true;
+                right_rotation(sibling, tree);
+                sibling = parent->right;
+            }
+            sibling->right->red = false;
+        }else{
+            if (!is_red(sibling->left)){
+                sibling->right->red = false;
+                sibling->red = true;
+                left_rotation(sibling, tree);
+                sibling = parent->left;
+            }
+            sibling->left->red = false;
+        }
+        sibling->red = parent->red;
+        parent->red = false;
+        if (left) left_rotation(parent, tree);
+        else right_rotation(parent, tree);
+        link = tree->root;
+        break;
+    }
+    if (link != NULL) link->red = false;
+}
+
+// returns the leftmost link of the subtree of given link
+static struct adt_rb_link *leftmost(struct adt_rb_link *link)
+{
+    while (link->left != NULL) link = link->left;
+    return link;
+}
+
+// returns the rightmost link of the subtree of given link
+static struct adt_rb_link *rightmost(struct adt_rb_link *link)
+{
+    while (link->right != NULL) link = link->right;
+    return link;
+}
+
+// prints given tree links, based on given print function, traversing the tree in-order
+static void print_links(struct adt_rb_link *link, RBLinkFunc print)
+{
+    if (link == NULL) return;
+    print_links(link->left, print);
+    print(link);
+    print_links(link->right, print);
+}
+
+// unlinks given tree links, destroying their structs with given destroy function
+static void destroy_links(struct adt_rb_link *link, RBLinkFunc destroy)
+{
+    if (link == NULL) return;
+    destroy_links(link->left, destroy);
+    destroy_links(link->right, destroy);
+    // the link is unlinked before its struct is destroyed, which may free it
+    link->left = link->right = link->parent = NULL;
+    if (destroy != NULL) destroy(link);
+}
+
+// Intrusive Red Black Tree ADT functions
+
+// initializes an empty intrusive red black tree
+void irbt_initialize(IntrusiveRedBlackTree *tree, LinkCompareFunc compare, KeyCompareFunc compare_key, RBLinkFunc destroy_func, RBLinkFunc print_func)
+{
+    *tree = malloc(sizeof(struct intrusive_rbt));
+    assert(*tree);
+    (*tree)->root = NULL;
+    (*tree)->size = 0;
+    (*tree)->Compare = compare;
+    (*tree)->CompareKey = compare_key;
+    irbt_set_destroy(*tree, destroy_func);
+    irbt_set_print(*tree, print_func);
+}
+
+// links given link in the right place in the tree
+// returns NULL, or the link of an equal struct that is already in the tree (given link is then not inserted)
+struct adt_rb_link *irbt_insert(struct adt_rb_link *link, IntrusiveRedBlackTree tree)
+{
+    // find the parent of the new link
+    struct adt_rb_link *parent = NULL, **child = &tree->root;
+    while (*child != NULL){
+        parent = *child;
+        int comp_result = tree->Compare(link, parent);
+        if (!comp_result) return parent; // already in the tree
+        child = comp_result < 0 ? &parent->left : &parent->right;
+    }
+    link->left = link->right = NULL;
+    link->parent = parent;
+    link->red = true;
+    *child = link;
+    tree->size++;
+    fix_double_red(link, tree);
+    return NULL;
+}
+
+// unlinks given link from the tree
+void irbt_remove(struct adt_rb_link *link, IntrusiveRedBlackTree tree)
+{
+    struct adt_rb_link *child, *parent;
+    bool removed_red;
+    if (link->left == NULL || link->right == NULL){
+        // the link is replaced by its only child (or NULL)
+        child = link->left != NULL ? link->left : link->right;
+        parent = link->parent;
+        removed_red = link->red;
+        replace_child(parent, link, child, tree);
+    }else{
+        // the link is replaced by its in-order successor, which is unlinked from its own place instead
+        struct adt_rb_link *successor = leftmost(link->right);
+        child = successor->right;
+        removed_red = successor->red;
+        if (successor->parent == link) parent = successor;
+        else{
+            parent = successor->parent;
+            replace_child(parent, successor, child, tree);
+            successor->right = link->right;
+            successor->right->parent = successor;
+        }
+        replace_child(link->parent, link, successor, tree);
+        successor->left = link->left;
+        successor->left->parent = successor;
+        successor->red = link->red;
+    }
+    link->left = link->right = link->parent = NULL;
+    tree->size--;
+    // removing a black link leaves its replacement double black
+    if (!removed_red) fix_double_black(child, parent, tree);
+}
+
+// returns the link of the struct equal to given key, or NULL if there is none
+struct adt_rb_link *irbt_find(Pointer key, IntrusiveRedBlackTree tree)
+{
+    struct adt_rb_link *link = tree->root;
+    while (link != NULL){
+        int comp_result = tree->CompareKey(key, link);
+        if (!comp_result) return link;
+        link = comp_result < 0 ? link->left : link->right;
+    }
+    return NULL;
+}
+
+// returns the link of the smallest struct of the tree, or NULL if tree is empty
+struct adt_rb_link *irbt_min(IntrusiveRedBlackTree tree)
+{
+    if (irbt_is_empty(tree)) return NULL;
+    return leftmost(tree->root);
+}
+
+// returns the link of the largest struct of the tree, or NULL if tree is empty
+struct adt_rb_link *irbt_max(IntrusiveRedBlackTree tree)
+{
+    if (irbt_is_empty(tree)) return NULL;
+    return rightmost(tree->root);
+}
+
+// returns the link after given link in-order, or NULL if it's the last one
+struct adt_rb_link *irbt_next(struct adt_rb_link *link)
+{
+    if (link->right != NULL) return leftmost(link->right);
+    while (link->parent != NULL && link->parent->right == link) link = link->parent;
+    return link->parent;
+}
+
+// returns the link before given link in-order, or NULL if it's the first one
+struct adt_rb_link *irbt_prev(struct adt_rb_link *link)
+{
+    if (link->left != NULL) return rightmost(link->left);
+    while (link->parent != NULL && link->parent->left == link) link = link->parent;
+    return link->parent;
+}
+
+// prints the structs of the tree in-order, based on the print function
+void irbt_print(IntrusiveRedBlackTree tree)
+{
+    if (tree->Print == NULL || irbt_is_empty(tree)) return;
+    print_links(tree->root, tree->Print);
+    printf("\n");
+}
+
+// destroys the given tree
+void irbt_destroy(IntrusiveRedBlackTree tree)
+{
+    destroy_links(tree->root, tree->Destroy);
+    free(tree);
+}
+
+// returns the number of links in the tree
+size_t irbt_size(IntrusiveRedBlackTree tree)
+{
+    return tree->size;
+}
+
+// returns true/false depending on if tree is empty or not
+bool irbt_is_empty(IntrusiveRedBlackTree tree)
+{
+    if (!irbt_size(tree)) return true;
+    else return false;
+}
+
+// sets as new destroy function of given tree the given one
+void irbt_set_destroy(IntrusiveRedBlackTree tree, RBLinkFunc destroy_func)
+{
+    tree->Destroy = destroy_func;
+}
+
+// sets as new print function of given tree the given one
+void irbt_set_print(IntrusiveRedBlackTree tree, RBLinkFunc print_func)
+{
+    tree->Print = print_func;
+}
@@ -0,0 +1,72 @@
+/* Interface file of Intrusive Red Black Tree ADT */
+
+#ifndef INTRUSIVE_RED_BLACK_TREE_H
+#define INTRUSIVE_RED_BLACK_TREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+// the tree link (struct adt_rb_link), embedded in the user's struct, and ADT_CONTAINER_OF
+#include "../Links/Links.h"
+
+/* pointer to function that compares the structs containing the links a and b. Returns:
+   < 0 if a < b
+   = 0 if a = b (based on given comparison)
+   > 0 if a > b                                                   */
+typedef int (*LinkCompareFunc)(struct adt_rb_link *a, struct adt_rb_link *b);
+
+// pointer to function that compares given key with the struct containing given link, like a LinkCompareFunc
+typedef int (*KeyCompareFunc)(Pointer key, struct adt_rb_link *link);
+
+// pointer to function that destroys or prints the struct containing given tree link
+typedef void (*RBLinkFunc)(struct adt_rb_link *);
+
+// pointer to intrusive red black tree
+typedef struct intrusive_rbt *IntrusiveRedBlackTree;
+
+/*-----Functions Provided-----*/
+
+// initializes an empty intrusive red black tree
+// the KeyCompareFunc is only needed by irbt_find
+void irbt_initialize(IntrusiveRedBlackTree *, LinkCompareFunc, KeyCompareFunc, RBLinkFunc destroy, RBLinkFunc print);
+
+// links given link in the right place in the tree
+// returns NULL, or the link of an equal struct that is already in the tree (given link is then not inserted)
+struct adt_rb_link *irbt_insert(struct adt_rb_link *, IntrusiveRedBlackTree);
+
+// unlinks given link (which must be in the tree) from the tree, without searching for it
+void irbt_remove(struct adt_rb_link *, IntrusiveRedBlackTree);
+
+// returns the link of the struct equal to given key, or NULL if there is none
+struct adt_rb_link *irbt_find(Pointer key, IntrusiveRedBlackTree);
+
+// returns the link of the smallest/largest struct of the tree, or NULL if tree is empty
+struct adt_rb_link *irbt_min(IntrusiveRedBlackTree);
+struct adt_rb_link *irbt_max(IntrusiveRedBlackTree);
+
+// returns the link after/before given link in-order, or NULL if it's the last/first one
+struct adt_rb_link *irbt_next(struct adt_rb_link *);
+struct adt_rb_link *irbt_prev(struct adt_rb_link *);
+
+// prints the structs of the tree in-order
+void irbt_print(IntrusiveRedBlackTree);
+
+// destroys the given tree, destroying the structs of the links that are still in it
+void irbt_destroy(IntrusiveRedBlackTree);
+
+// returns the number of links in the tree
+size_t irbt_size(IntrusiveRedBlackTree);
+
+// returns true/false depending on if tree is empty or not
+bool irbt_is_empty(IntrusiveRedBlackTree);
+
+// sets as new destroy function of given tree the given one
+void irbt_set_destroy(IntrusiveRedBlackTree, RBLinkFunc);
+
+// sets as new print function of given tree the given one
+void irbt_set_print(IntrusiveRedBlackTree, RBLinkFunc);
+
+#endif
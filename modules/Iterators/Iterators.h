@@ -0,0 +1,52 @@
+/* Iterator structs of the ADT modules, shared by the module headers and lib/ADT.h */
+
+#ifndef ADT_ITERATORS_H
+#define ADT_ITERATORS_H
+
+#include <stddef.h>
+
+/* Iterators are declared by the user (usually as local variables), initialized with the *_iterator_init function
+   of their module and advanced with its *_iterator_next function, which returns NULL after the last item.
+   An iterator stays valid as long as its container isn't changed. Their fields are private to the modules.  */
+
+// iterator over the items of a stack, from the top to the bottom
+typedef struct stack_iterator{
+    struct stack_block *block; // block of the next item
+    int index; // the next item is the one before this index of the block
+}StackIterator;
+
+// iterator over the items of a queue, from the front to the rear
+typedef struct queue_iterator{
+    struct queue_block *block; // block of the next item
+    int index; // index of the next item in the block
+}QueueIterator;
+
+// iterator over the items of a deque, from the front to the back
+typedef struct deque_iterator{
+    struct deque_node *node; // node of the next item
+}DequeIterator;
+
+// iterator over the items of a priority queue, in heap order (not sorted)
+typedef struct pq_iterator{
+    struct priority_queue *pq; // the iterated priority queue
+    size_t index; // heap index of the next item
+}PQIterator;
+
+// iterator over the items of a circular list, once around, starting from the cursor
+typedef struct cl_iterator{
+    struct cl_node *node; // node of the next item
+    size_t remaining; // number of items not visited yet
+}CLIterator;
+
+// iterator over the items of a bst, in-order (ascending)
+typedef struct bst_iterator{
+    struct binary_search_tree *bst; // the iterated bst
+    struct bst_node *node; // node of the next item
+}BSTIterator;
+
+// iterator over the items of a red black tree, in-order (ascending)
+typedef struct rbt_iterator{
+    struct rbt_node *node; // node of the next item
+}RBTIterator;
+
+#endif
@@ -0,0 +1,25 @@
+/* Links of the intrusive modules, shared by the module headers and lib/ADT.h */
+
+#ifndef ADT_LINKS_H
+#define ADT_LINKS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// list link, embedded in the user's struct (one link per list that the struct can be in at the same time)
+struct adt_list_link{
+    struct adt_list_link *next; // pointer to the next link of the list
+    struct adt_list_link *prev; // pointer to the previous link of the list
+};
+
+// tree link, embedded in the user's struct (one link per tree that the struct can be in at the same time)
+struct adt_rb_link{
+    struct adt_rb_link *left, *right; // pointers to the link's left and right children
+    struct adt_rb_link *parent; // pointer to the link's parent
+    bool red; // link's color
+};
+
+// returns a pointer to the struct of given type that contains the link pointed by ptr as given member
+#define ADT_CONTAINER_OF(ptr, type, member) ((type *)((char *)(ptr) - offsetof(type, member)))
+
+#endif
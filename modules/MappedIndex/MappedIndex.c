@@ -0,0 +1,227 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "MappedIndex.h"
+
+// index file header
+#define INDEX_MAGIC "ADTMIDX"
+#define INDEX_VERSION 1
+#define HEADER_SIZE 64
+
+#ifdef __GNUC__
+#define PREFETCH(address) __builtin_prefetch(address)
+#define FIND_FIRST_SET(x) __builtin_ffsl((long)(x))
+#else
+#define PREFETCH(address) ((void)(address))
+// returns one plus the index of the least significant set bit of x (0 if x is 0)
+static int FIND_FIRST_SET(size_t x)
+{
+    if (!x) return 0;
+    int bit = 1;
+    while (!(x & 1)){
+        x >>= 1;
+        bit++;
+    }
+    return bit;
+}
+#endif
+
+/* Layout of an index file:
+   a HEADER_SIZE-byte header, followed by the records in Eytzinger (BFS) order, where every record is
+   key_size bytes of key followed by value_size bytes of value. Record 1 is the root of an implicit
+   balanced search tree, and the children of record k are records 2k and 2k+1.
+   Numbers are stored in the byte order of the machine that wrote the file.                           */
+typedef struct index_header{
+    char magic[8]; // INDEX_MAGIC
+    uint32_t version; // INDEX_VERSION
+    uint32_t key_size; // bytes of each record's key
+    uint32_t value_size; // bytes of each record's value
+    uint32_t unused;
+    uint64_t count; // number of records
+}index_header;
+
+// mapped index struct
+struct mapped_index{
+    unsigned char *map; // start of the mapped file
+    size_t map_size; // size of the mapped file
+    unsigned char *records; // start of the records (record k is at records + (k - 1) * record_size)
+    size_t size; // number of records
+    int key_size; // bytes of each record's key
+    size_t record_size; // bytes of each record (key and value)
+    CompareFunc Compare;
+};
+
+// Eytzinger layout functions
+
+// stores in order[k] the index of the sorted item that goes to position k, for all positions of the subtree of k
+// returns the index of the first sorted item that wasn't placed
+static size_t fill_eytzinger(size_t *order, size_t n, size_t i, size_t k)
+{
+    if (k > n) return i;
+    i = fill_eytzinger(order, n, i, 2 * k);
+    order[k] = i++;
+    return fill_eytzinger(order, n, i, 2 * k + 1);
+}
+
+// returns the position of the record that follows the one at position k in key order, or 0 if there is none
+static size_t next_position(size_t k, size_t n)
+{
+    // the successor is the leftmost record of the right subtree
+    if (2 * k + 1 <= n){
+        k = 2 * k + 1;
+        while (2 * k <= n) k = 2 * k;
+        return k;
+    }
+    // else; it's the first ancestor whose left subtree contains k
+    while (k & 1) k >>= 1;
+    return k >> 1;
+}
+
+// returns a pointer to the key of the record at position k
+static Pointer record_key(MappedIndex mi, size_t k)
+{
+    return mi->records + (k - 1) * mi->record_size;
+}
+
+// compares the key of the record at position k with given key
+static int compare_record(MappedIndex mi, size_t k, Pointer key)
+{
+    if (mi->Compare == NULL) return memcmp(record_key(mi, k), key, mi->key_size);
+    return mi->Compare(record_key(mi, k), key);
+}
+
+// returns the position of the first record with key not less than given key, or 0 if there is none
+static size_t lower_bound_position(Pointer key, MappedIndex mi)
+{
+    size_t k = 1;
+    while (k <= mi->size){
+        // prefetch the grandchildren of k, which are stored next to each other
+        PREFETCH(record_key(mi, 4 * k));
+        k = 2 * k + (compare_record(mi, k, key) < 0);
+    }
+    return k >> FIND_FIRST_SET(~k);
+}
+
+// Mapped Index ADT functions
+
+// writes an index file with the n sorted items of given array
+bool mi_write_sorted(const char *path, Pointer *items, size_t n, EncodeFunc encode, int key_size, int value_size)
+{
+    if (key_size <= 0 || value_size < 0) return false;
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) return false;
+    // write the header
+    index_header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.key_size = key_size;
+    header.value_size = value_size;
+    header.count = n;
+    unsigned char padding[HEADER_SIZE - sizeof(index_header)];
+    memset(padding, 0, sizeof(padding));
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(padding, sizeof(padding), 1, file) == 1;
+    // find the sorted item of each position and write the records in position order
+    size_t *order = malloc((n + 1) * sizeof(size_t));
+    assert(order);
+    fill_eytzinger(order, n, 0, 1);
+    unsigned char *record = malloc(key_size + value_size);
+    assert(record);
+    for (size_t k = 1; ok && k <= n; k++){
+        memset(record, 0, key_size + value_size);
+        encode(items[order[k]], record, record + key_size);
+        ok = fwrite(record, key_size + value_size, 1, file) == 1;
+    }
+    free(record);
+    free(order);
+    if (fclose(file)) ok = false;
+    return ok;
+}
+
+// opens the index file of given path by mapping it in memory
+bool mi_open(MappedIndex *mi, const char *path, CompareFunc compare)
+{
+    *mi = NULL;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) || st.st_size < HEADER_SIZE){
+        close(fd);
+        return false;
+    }
+    // the mapping stays valid after the file is closed
+    unsigned char *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return false;
+    // check the header and that the file holds all records
+    index_header header;
+    memcpy(&header, map, sizeof(header));
+    size_t record_size = (size_t)header.key_size + header.value_size;
+    if (memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) || header.version != INDEX_VERSION || !header.key_size ||
+        header.count > ((uint64_t)st.st_size - HEADER_SIZE) / record_size){
+        munmap(map, st.st_size);
+        return false;
+    }
+    *mi = malloc(sizeof(struct mapped_index));
+    assert(*mi);
+    (*mi)->map = map;
+    (*mi)->map_size = st.st_size;
+    (*mi)->records = map + HEADER_SIZE;
+    (*mi)->size = header.count;
+    (*mi)->key_size = header.key_size;
+    (*mi)->record_size = record_size;
+    (*mi)->Compare = compare;
+    return true;
+}
+
+// returns a pointer to the value of the record with given key, or NULL if not found
+Pointer mi_search(Pointer key, MappedIndex mi)
+{
+    size_t k = lower_bound_position(key, mi);
+    if (!k || compare_record(mi, k, key)) return NULL;
+    return (unsigned char *)record_key(mi, k) + mi->key_size;
+}
+
+// visits the records with keys from low to high in ascending order
+size_t mi_range(Pointer low, Pointer high, RecordFunc visit, void *context, MappedIndex mi)
+{
+    size_t visited = 0;
+    // find the first record of the range; without a lower limit, it's the leftmost record
+    size_t k = 1;
+    if (low != NULL) k = lower_bound_position(low, mi);
+    else if (mi->size) while (2 * k <= mi->size) k = 2 * k;
+    else k = 0;
+    while (k && (high == NULL || compare_record(mi, k, high) <= 0)){
+        visited++;
+        Pointer key = record_key(mi, k);
+        if (!visit(key, (unsigned char *)key + mi->key_size, context)) break;
+        k = next_position(k, mi->size);
+    }
+    return visited;
+}
+
+// returns the number of records in the mapped index
+size_t mi_size(MappedIndex mi)
+{
+    return mi->size;
+}
+
+// returns true/false depending on if mapped index is empty or not
+bool mi_is_empty(MappedIndex mi)
+{
+    if (!mi_size(mi)) return true;
+    else return false;
+}
+
+// unmaps the index file and destroys the given mapped index
+void mi_close(MappedIndex mi)
+{
+    munmap(mi->map, mi->map_size);
+    free(mi);
+}
@@ -0,0 +1,60 @@
+/* Interface file of Mapped Index ADT */
+
+#ifndef MAPPED_INDEX_H
+#define MAPPED_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+/* pointer to function that compares two elements a and b. Returns:
+   < 0 if a < b
+   = 0 if a = b (based on given comparison)
+   > 0 if a > b                                                   */
+typedef int (*CompareFunc)(Pointer a, Pointer b);
+
+// pointer to function that encodes given element into a fixed-size key and a fixed-size value
+// (key and value point to key_size and value_size zeroed bytes respectively)
+typedef void (*EncodeFunc)(Pointer item, Pointer key, Pointer value);
+
+// pointer to function called for each record visited by a range query, with given context
+// returns false to stop the query
+typedef bool (*RecordFunc)(Pointer key, Pointer value, void *context);
+
+// pointer to mapped index
+typedef struct mapped_index *MappedIndex;
+
+/*-----Functions Provided-----*/
+
+// writes an index file with the n items of given array, encoded with given EncodeFunc
+// the items must be sorted in ascending order (based on the order of their encoded keys) and distinct
+// (a red black tree can also be exported to an index file with red_black_export)
+// returns true on success
+bool mi_write_sorted(const char *path, Pointer *items, size_t n, EncodeFunc, int key_size, int value_size);
+
+// opens the index file of given path by mapping it in memory; keys are compared with given CompareFunc
+// (NULL compares keys byte by byte, which orders e.g. big-endian integers or padded strings)
+// returns false if the file can't be opened or isn't an index file
+bool mi_open(MappedIndex *, const char *path, CompareFunc);
+
+// returns a pointer to the value of the record with given key, inside the mapped file
+// returns NULL if not found
+Pointer mi_search(Pointer key, MappedIndex);
+
+// calls given RecordFunc for the records with keys from low to high (inclusive) in ascending order
+// NULL low/high means no lower/upper limit
+// returns the number of visited records
+size_t mi_range(Pointer low, Pointer high, RecordFunc, void *context, MappedIndex);
+
+// returns the number of records in the mapped index
+size_t mi_size(MappedIndex);
+
+// returns true/false depending on if mapped index is empty or not
+bool mi_is_empty(MappedIndex);
+
+// unmaps the index file and destroys the given mapped index
+void mi_close(MappedIndex);
+
+#endif
@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "MonotonicDeque.h"
+
+// initial capacity of the monotonic deque's ring (a power of 2)
+#define MD_MIN_CAPACITY 16
+
+// entry of the ring
+typedef struct md_entry{
+    Pointer data; // pointer to the item
+    unsigned long stamp; // time stamp the item was pushed with
+}md_entry;
+
+// monotonic deque struct
+/* The kept items are in a ring buffer, from the oldest at the front to the newest at the back, and they are in
+   strictly increasing order: pushing an item first drops the items at the back that aren't smaller than it.
+   So the front is always the min of the window, and expiring removes items from the front. Every item is pushed
+   and removed once, so both operations take O(1) amortized time, without any allocations once the ring is big enough. */
+struct monotonic_deque{
+    md_entry *ring; // array of the entries, used as a ring buffer
+    size_t capacity; // number of entries the ring can hold (a power of 2)
+    size_t front; // index of the oldest entry
+    size_t size; // number of kept entries
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
+    CompareFunc Compare;
+    DestroyFunc Destroy;
+    PrintFunc Print;
+};
+
+// ring functions
+
+// returns the entry at given position of the deque, counting from the front
+static md_entry *get_entry(MonotonicDeque md, size_t position)
+{
+    return &md->ring[(md->front + position) & (md->capacity - 1)];
+}
+
+// doubles the capacity of the ring, moving the entries to the start of the new array
+static void grow_ring(MonotonicDeque md)
+{
+    size_t new_capacity = md->capacity ? 2 * md->capacity : MD_MIN_CAPACITY;
+    md_entry *ring = malloc(new_capacity * sizeof(md_entry));
+    assert(ring);
+    STATS_INC(md, allocations);
+    if (md->size){
+        // the entries may wrap around the end of the old ring
+        size_t first = md->capacity - md->front < md->size ? md->capacity - md->front : md->size;
+        memcpy(ring, &md->ring[md->front], first * sizeof(md_entry));
+        memcpy(&ring[first], md->ring, (md->size - first) * sizeof(md_entry));
+    }
+    if (md->ring != NULL){
+        free(md->ring);
+        STATS_INC(md, frees);
+    }
+    md->ring = ring;
+    md->capacity = new_capacity;
+    md->front = 0;
+}
+
+// removes the front entry and destroys its item
+static void remove_front(MonotonicDeque md)
+{
+    if (md->Destroy != NULL) md->Destroy(get_entry(md, 0)->data);
+    md->front = (md->front + 1) & (md->capacity - 1);
+    md->size--;
+    STATS_INC(md, removes);
+}
+
+// Monotonic Deque ADT functions
+
+// initializes an empty monotonic deque
+void md_initialize(MonotonicDeque *md, CompareFunc compare, DestroyFunc destroy, PrintFunc print)
+{
+    *md = malloc(sizeof(struct monotonic_deque));
+    assert(*md);
+    (*md)->ring = NULL;
+    (*md)->capacity = 0;
+    (*md)->front = 0;
+    (*md)->size = 0;
+    md_reset_stats(*md);
+    (*md)->Compare = compare;
+    md_set_destroy(*md, destroy);
+    md_set_print(*md, print);
+}
+
+// pushes given item with given time stamp
+void md_push(Pointer item, unsigned long stamp, MonotonicDeque md)
+{
+    // drop the newest items that aren't smaller than the new item; they expire before it, so they can't be the min anymore
+    while (md->size){
+        md_entry *back = get_entry(md, md->size - 1);
+        STATS_INC(md, comparisons);
+        if (md->Compare(back->data, item) < 0) break;
+        if (md->Destroy != NULL) md->Destroy(back->data);
+        md->size--;
+        STATS_INC(md, removes);
+    }
+    if (md->size == md->capacity) grow_ring(md);
+    md_entry *entry = get_entry(md, md->size);
+    entry->data = item;
+    entry->stamp = stamp;
+    md->size++;
+    STATS_INC(md, inserts);
+    STATS_MAX(md, peak_size, md->size);
+}
+
+// expires and destroys the items with stamps smaller than given stamp
+size_t md_expire(unsigned long stamp, MonotonicDeque md)
+{
+    size_t expired = 0;
+    while (md->size && get_entry(md, 0)->stamp < stamp){
+        remove_front(md);
+        expired++;
+    }
+    return expired;
+}
+
+// returns the min item of the window, or NULL if it's empty
+Pointer md_min(MonotonicDeque md)
+{
+    return md->size ? get_entry(md, 0)->data : NULL;
+}
+
+// returns the time stamp of the min item of the window (0 if it's empty)
+unsigned long md_min_stamp(MonotonicDeque md)
+{
+    return md->size ? get_entry(md, 0)->stamp : 0;
+}
+
+// prints the items kept in the deque based on given PrintFunc, from the oldest to the newest
+void md_print(MonotonicDeque md)
+{
+    // check if a PrintFunc exists and if deque isn't empty
+    if (md->Print == NULL || md_is_empty(md)) return;
+    for (size_t i = 0; i < md->size; i++) md->Print(get_entry(md, i)->data);
+    printf("\n");
+}
+
+// destroys the given deque
+void md_destroy(MonotonicDeque md)
+{
+    while (md->size) remove_front(md);
+    free(md->ring);
+    free(md);
+}
+
+// returns the number of items kept in the deque
+size_t md_size(MonotonicDeque md)
+{
+    return md->size;
+}
+
+// returns true/false depending on if the window is empty or not
+bool md_is_empty(MonotonicDeque md)
+{
+    if (!md_size(md)) return true;
+    else return false;
+}
+
+// returns the operation counters of the deque
+AdtStats md_get_stats(MonotonicDeque md)
+{
+#ifdef ADT_STATS
+    return md->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the deque; the peak size becomes the current size
+void md_reset_stats(MonotonicDeque md)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = md->size;
+    md->stats = stats;
+#endif
+}
+
+// sets as new DestroyFunc of given deque the given one
+void md_set_destroy(MonotonicDeque md, DestroyFunc destroy_func)
+{
+    md->Destroy = destroy_func;
+}
+
+// sets as new PrintFunc of given deque the given one
+void md_set_print(MonotonicDeque md, PrintFunc print_func)
+{
+    md->Print = print_func;
+}
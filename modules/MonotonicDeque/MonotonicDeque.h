@@ -0,0 +1,75 @@
+/* Interface file of Monotonic Deque ADT */
+
+#ifndef MONOTONIC_DEQUE_H
+#define MONOTONIC_DEQUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+/* pointer to function that compares two elements a and b. Returns:
+   < 0 if a < b
+   = 0 if a = b (based on given comparison)
+   > 0 if a > b                                                   */
+typedef int (*CompareFunc)(Pointer a, Pointer b);
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to function printing deque's item
+typedef void (*PrintFunc)(Pointer);
+
+// pointer to monotonic deque
+typedef struct monotonic_deque *MonotonicDeque;
+
+/*-----Functions Provided-----*/
+/* A monotonic deque answers the min of a sliding window of items: every item is pushed with a time stamp, and the
+   items older than a given stamp are expired as the window slides. The min is based on the CompareFunc; a reversed
+   CompareFunc gives the max. Only the items that can still become the min are kept: an item is dropped (and
+   destroyed) as soon as a newer item that isn't greater is pushed, since it would expire before that item.     */
+
+// initializes an empty monotonic deque
+void md_initialize(MonotonicDeque *, CompareFunc, DestroyFunc, PrintFunc);
+
+// pushes given item with given time stamp, which can't be smaller than the stamps of the items pushed before it
+// the items that aren't smaller than the new item are dropped and destroyed
+void md_push(Pointer, unsigned long stamp, MonotonicDeque);
+
+// expires and destroys the items with stamps smaller than given stamp
+// returns the number of expired items
+size_t md_expire(unsigned long stamp, MonotonicDeque);
+
+// returns the min item of the window (the items pushed and not expired), or NULL if it's empty
+Pointer md_min(MonotonicDeque);
+
+// returns the time stamp of the min item of the window (0 if it's empty)
+unsigned long md_min_stamp(MonotonicDeque);
+
+// prints the items kept in the deque, from the oldest (the min) to the newest
+void md_print(MonotonicDeque);
+
+// destroys the given deque, along with its items
+void md_destroy(MonotonicDeque);
+
+// returns the number of items kept in the deque (not the number of items in the window)
+size_t md_size(MonotonicDeque);
+
+// returns true/false depending on if the window is empty or not
+bool md_is_empty(MonotonicDeque);
+
+// returns the operation counters of the deque (see Stats.h)
+AdtStats md_get_stats(MonotonicDeque);
+
+// resets the operation counters of the deque; the peak size becomes the current size
+void md_reset_stats(MonotonicDeque);
+
+// sets as new DestroyFunc of given deque the given one
+void md_set_destroy(MonotonicDeque, DestroyFunc);
+
+// sets as new PrintFunc of given deque the given one
+void md_set_print(MonotonicDeque, PrintFunc);
+
+#endif
@@ -0,0 +1,398 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <assert.h>
+#include "PersistentTree.h"
+
+// node color enum
+typedef enum{
+    RED, BLACK
+}Color;
+
+// item struct, shared by all copies of the node holding it
+typedef struct pt_item{
+    Pointer data; // pointer to the item data
+    atomic_int refs; // number of nodes holding the item
+}pt_item;
+
+// persistent tree node struct
+/* Nodes are never modified after they are created. An update copies the nodes on the path to the changed node
+   (path copying) and shares all other nodes with the previous version; refs counts the parents and versions
+   that use a node, and the node is freed when it drops to 0. Empty subtrees are NULL.                         */
+typedef struct pt_node{
+    pt_item *item; // pointer to the node item
+    Color color; // node's color
+    struct pt_node *left, *right; // pointers to node's left and right children
+    atomic_int refs; // number of references to the node
+}pt_node;
+
+// persistent tree (version) struct
+struct persistent_tree{
+    pt_node *root; // pointer to the root of the version
+    size_t size; // number of elements in the version
+    CompareFunc Compare;
+    DestroyFunc Destroy;
+    PrintFunc Print;
+};
+
+// reference counting functions
+/* The functions below consume the references to the nodes and items they are given
+   and return a new reference, unless stated otherwise.                               */
+
+// adds a reference to given node (if not empty) and returns it
+static pt_node *retain(pt_node *node)
+{
+    if (node != NULL) atomic_fetch_add_explicit(&node->refs, 1, memory_order_relaxed);
+    return node;
+}
+
+// adds a reference to given item and returns it
+static pt_item *retain_item(pt_item *item)
+{
+    atomic_fetch_add_explicit(&item->refs, 1, memory_order_relaxed);
+    return item;
+}
+
+// drops a reference to given item; destroys it if it was the last one
+static void release_item(pt_item *item, DestroyFunc destroy)
+{
+    if (atomic_fetch_sub_explicit(&item->refs, 1, memory_order_acq_rel) != 1) return;
+    if (destroy != NULL) destroy(item->data);
+    free(item);
+}
+
+// drops a reference to given node; frees it (and releases its children and item) if it was the last one
+static void release(pt_node *node, DestroyFunc destroy)
+{
+    while (node != NULL && atomic_fetch_sub_explicit(&node->refs, 1, memory_order_acq_rel) == 1){
+        pt_node *right = node->right;
+        release(node->left, destroy);
+        release_item(node->item, destroy);
+        free(node);
+        // continue with the right child, instead of recursing
+        node = right;
+    }
+}
+
+// creates a new node with given color, children and item
+static pt_node *make_node(Color color, pt_node *left, pt_item *item, pt_node *right)
+{
+    pt_node *node = malloc(sizeof(pt_node));
+    assert(node);
+    node->item = item;
+    node->color = color;
+    node->left = left;
+    node->right = right;
+    atomic_init(&node->refs, 1);
+    return node;
+}
+
+// creates a new item holding given data
+static pt_item *make_item(Pointer data)
+{
+    pt_item *item = malloc(sizeof(pt_item));
+    assert(item);
+    item->data = data;
+    atomic_init(&item->refs, 1);
+    return item;
+}
+
+// splits given node into references to its children and item
+static void unpack(pt_node *node, pt_node **left, pt_item **item, pt_node **right, DestroyFunc destroy)
+{
+    // if this is the only reference, the node's references can be moved instead of copied
+    if (atomic_load_explicit(&node->refs, memory_order_acquire) == 1){
+        *left = node->left;
+        *item = node->item;
+        *right = node->right;
+        free(node);
+        return;
+    }
+    *left = retain(node->left);
+    *item = retain_item(node->item);
+    *right = retain(node->right);
+    release(node, destroy);
+}
+
+// returns a node equal to given (non-empty) node, colored with given color
+static pt_node *paint(pt_node *node, Color color, DestroyFunc destroy)
+{
+    if (node->color == color) return node;
+    pt_node *left, *right;
+    pt_item *item;
+    unpack(node, &left, &item, &right, destroy);
+    return make_node(color, left, item, right);
+}
+
+// returns true if given node is red
+static bool is_red(pt_node *node)
+{
+    return node != NULL && node->color == RED;
+}
+
+// returns true if given node is black (and not empty)
+static bool is_black(pt_node *node)
+{
+    return node != NULL && node->color == BLACK;
+}
+
+// red black tree functions (following S. Kahrs, "Red-black trees with types")
+
+// returns a black node with given children and item, after fixing a red node with a red child among its children
+static pt_node *balance(pt_node *l, pt_item *x, pt_node *r, DestroyFunc destroy)
+{
+    pt_node *a, *b, *c, *d, *t;
+    pt_item *y, *z;
+    // both children are red; push the redness up
+    if (is_red(l) && is_red(r)) return make_node(RED, paint(l, BLACK, destroy), x, paint(r, BLACK, destroy));
+    if (is_red(l) && is_red(l->left)){
+        unpack(l, &t, &y, &c, destroy);
+        unpack(t, &a, &z, &b, destroy);
+        return make_node(RED, make_node(BLACK, a, z, b), y, make_node(BLACK, c, x, r));
+    }
+    if (is_red(l) && is_red(l->right)){
+        unpack(l, &a, &z, &t, destroy);
+        unpack(t, &b, &y, &c, destroy);
+        return make_node(RED, make_node(BLACK, a, z, b), y, make_node(BLACK, c, x, r));
+    }
+    if (is_red(r) && is_red(r->right)){
+        unpack(r, &b, &y, &t, destroy);
+        unpack(t, &c, &z, &d, destroy);
+        return make_node(RED, make_node(BLACK, l, x, b), y, make_node(BLACK, c, z, d));
+    }
+    if (is_red(r) && is_red(r->left)){
+        unpack(r, &t, &z, &d, destroy);
+        unpack(t, &b, &y, &c, destroy);
+        return make_node(RED, make_node(BLACK, l, x, b), y, make_node(BLACK, c, z, d));
+    }
+    return make_node(BLACK, l, x, r);
+}
+
+// rebuilds a node whose left subtree (bl) has one less black node than its right subtree
+static pt_node *balance_left(pt_node *bl, pt_item *x, pt_node *r, DestroyFunc destroy)
+{
+    pt_node *a, *b, *c, *t;
+    pt_item *y, *z;
+    if (is_red(bl)) return make_node(RED, paint(bl, BLACK, destroy), x, r);
+    if (is_black(r)) return balance(bl, x, paint(r, RED, destroy), destroy);
+    assert(is_red(r) && is_black(r->left));
+    unpack(r, &t, &z, &c, destroy);
+    unpack(t, &a, &y, &b, destroy);
+    return make_node(RED, make_node(BLACK, bl, x, a), y, balance(b, z, paint(c, RED, destroy), destroy));
+}
+
+// rebuilds a node whose right subtree (br) has one less black node than its left subtree
+static pt_node *balance_right(pt_node *l, pt_item *x, pt_node *br, DestroyFunc destroy)
+{
+    pt_node *a, *b, *c, *t;
+    pt_item *y, *z;
+    if (is_red(br)) return make_node(RED, l, x, paint(br, BLACK, destroy));
+    if (is_black(l)) return balance(paint(l, RED, destroy), x, br, destroy);
+    assert(is_red(l) && is_black(l->right));
+    unpack(l, &a, &z, &t, destroy);
+    unpack(t, &b, &y, &c, destroy);
+    return make_node(RED, balance(paint(a, RED, destroy), z, b, destroy), y, make_node(BLACK, c, x, br));
+}
+
+// joins the two subtrees of a removed node (all items of a are less than the items of b)
+static pt_node *append(pt_node *a, pt_node *b, DestroyFunc destroy)
+{
+    if (a == NULL) return b;
+    if (b == NULL) return a;
+    pt_node *al, *ar, *bl, *br, *bc, *t1, *t2;
+    pt_item *x, *y, *z;
+    if (a->color == b->color){
+        Color color = a->color;
+        unpack(a, &al, &x, &ar, destroy);
+        unpack(b, &bl, &y, &br, destroy);
+        bc = append(ar, bl, destroy);
+        if (is_red(bc)){
+            unpack(bc, &t1, &z, &t2, destroy);
+            return make_node(RED, make_node(color, al, x, t1), z, make_node(color, t2, y, br));
+        }
+        if (color == RED) return make_node(RED, al, x, make_node(RED, bc, y, br));
+        return balance_left(al, x, make_node(BLACK, bc, y, br), destroy);
+    }
+    if (is_red(b)){
+        unpack(b, &bl, &y, &br, destroy);
+        return make_node(RED, append(a, bl, destroy), y, br);
+    }
+    unpack(a, &al, &x, &ar, destroy);
+    return make_node(RED, al, x, append(ar, b, destroy));
+}
+
+// returns a new subtree of given (borrowed) node, that also holds given item
+static pt_node *insert_node(pt_node *node, Pointer data, pt_item *new_item, PersistentTree pt)
+{
+    if (node == NULL) return make_node(RED, NULL, new_item, NULL);
+    pt_item *item = retain_item(node->item);
+    if (pt->Compare(data, node->item->data) < 0){
+        pt_node *left = insert_node(node->left, data, new_item, pt);
+        if (node->color == BLACK) return balance(left, item, retain(node->right), pt->Destroy);
+        return make_node(RED, left, item, retain(node->right));
+    }
+    pt_node *right = insert_node(node->right, data, new_item, pt);
+    if (node->color == BLACK) return balance(retain(node->left), item, right, pt->Destroy);
+    return make_node(RED, retain(node->left), item, right);
+}
+
+// returns a new subtree of given (borrowed) node, without given item (which must exist in the subtree)
+static pt_node *remove_node(pt_node *node, Pointer data, PersistentTree pt)
+{
+    int comp_result = pt->Compare(data, node->item->data);
+    if (comp_result < 0){
+        pt_node *left = remove_node(node->left, data, pt);
+        if (is_black(node->left)) return balance_left(left, retain_item(node->item), retain(node->right), pt->Destroy);
+        return make_node(RED, left, retain_item(node->item), retain(node->right));
+    }
+    if (comp_result > 0){
+        pt_node *right = remove_node(node->right, data, pt);
+        if (is_black(node->right)) return balance_right(retain(node->left), retain_item(node->item), right, pt->Destroy);
+        return make_node(RED, retain(node->left), retain_item(node->item), right);
+    }
+    // found; the new subtree doesn't hold the node's item
+    return append(retain(node->left), retain(node->right), pt->Destroy);
+}
+
+// finds the node of given item in the subtree of given node
+// returns NULL if not found
+static pt_node *find_node(pt_node *node, Pointer data, CompareFunc compare)
+{
+    while (node != NULL){
+        int comp_result = compare(data, node->item->data);
+        if (!comp_result) return node; // found
+        node = comp_result < 0 ? node->left : node->right;
+    }
+    return NULL;
+}
+
+// prints given subtree's items, based on given PrintFunc, traversing the tree in-order
+static void print_tree_nodes(pt_node *node, PrintFunc print)
+{
+    if (node == NULL) return;
+    print_tree_nodes(node->left, print);
+    print(node->item->data);
+    print_tree_nodes(node->right, print);
+}
+
+// returns a new version with given root and size and the functions of given version
+static PersistentTree new_version(pt_node *root, size_t size, PersistentTree pt)
+{
+    PersistentTree version = malloc(sizeof(struct persistent_tree));
+    assert(version);
+    version->root = root;
+    version->size = size;
+    version->Compare = pt->Compare;
+    version->Destroy = pt->Destroy;
+    version->Print = pt->Print;
+    return version;
+}
+
+// Persistent Tree ADT functions
+
+// initializes an empty persistent tree
+void ptree_initialize(PersistentTree *pt, CompareFunc compare, DestroyFunc destroy, PrintFunc print)
+{
+    *pt = malloc(sizeof(struct persistent_tree));
+    assert(*pt);
+    (*pt)->root = NULL;
+    (*pt)->size = 0;
+    (*pt)->Compare = compare;
+    ptree_set_destroy(*pt, destroy);
+    ptree_set_print(*pt, print);
+}
+
+// returns a new version of the tree that also holds given item
+PersistentTree ptree_insert(Pointer item, PersistentTree pt)
+{
+    // no duplicates are allowed
+    if (ptree_search(item, pt)) return ptree_snapshot(pt);
+    pt_node *root = insert_node(pt->root, item, make_item(item), pt);
+    return new_version(paint(root, BLACK, pt->Destroy), pt->size + 1, pt);
+}
+
+// returns a new version of the tree without given item
+PersistentTree ptree_remove(Pointer item, PersistentTree pt)
+{
+    if (!ptree_search(item, pt)) return ptree_snapshot(pt);
+    pt_node *root = remove_node(pt->root, item, pt);
+    if (root != NULL) root = paint(root, BLACK, pt->Destroy);
+    return new_version(root, pt->size - 1, pt);
+}
+
+// returns a new handle to the same version of the tree
+PersistentTree ptree_snapshot(PersistentTree pt)
+{
+    return new_version(retain(pt->root), pt->size, pt);
+}
+
+// prints items of the version
+void ptree_print(PersistentTree pt)
+{
+    if (pt->Print == NULL || ptree_is_empty(pt)) return;
+    print_tree_nodes(pt->root, pt->Print);
+    printf("\n");
+}
+
+// destroys the given version
+void ptree_destroy(PersistentTree pt)
+{
+    release(pt->root, pt->Destroy);
+    free(pt);
+}
+
+// returns the number of elements in the version
+size_t ptree_size(PersistentTree pt)
+{
+    return pt->size;
+}
+
+// returns true/false depending on if the version is empty or not
+bool ptree_is_empty(PersistentTree pt)
+{
+    if (!ptree_size(pt)) return true;
+    else return false;
+}
+
+// returns true/false based on if given item is found in the version or not
+bool ptree_search(Pointer item, PersistentTree pt)
+{
+    return find_node(pt->root, item, pt->Compare) != NULL ? true : false;
+}
+
+// returns the element of the version that is equal to given item, or NULL if not found
+Pointer ptree_find(Pointer item, PersistentTree pt)
+{
+    pt_node *node = find_node(pt->root, item, pt->Compare);
+    return node != NULL ? node->item->data : NULL;
+}
+
+// returns the smallest/element with min key of the version
+Pointer ptree_min(PersistentTree pt)
+{
+    if (ptree_is_empty(pt)) return NULL;
+    pt_node *min = pt->root;
+    while (min->left != NULL) min = min->left;
+    return min->item->data;
+}
+
+// returns the largest/element with max key of the version
+Pointer ptree_max(PersistentTree pt)
+{
+    if (ptree_is_empty(pt)) return NULL;
+    pt_node *max = pt->root;
+    while (max->right != NULL) max = max->right;
+    return max->item->data;
+}
+
+// sets as new DestroyFunc of given version the given one
+void ptree_set_destroy(PersistentTree pt, DestroyFunc destroy)
+{
+    pt->Destroy = destroy;
+}
+
+// sets as new PrintFunc of given version the given one
+void ptree_set_print(PersistentTree pt, PrintFunc print)
+{
+    pt->Print = print;
+}
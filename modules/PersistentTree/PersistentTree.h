@@ -0,0 +1,78 @@
+/* Interface file of Persistent (Red Black) Tree ADT */
+
+#ifndef PERSISTENT_TREE_H
+#define PERSISTENT_TREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+/* pointer to function that compares two elements a and b. Returns:
+   < 0 if a < b
+   = 0 if a = b (based on given comparison)
+   > 0 if a > b                                                   */
+typedef int (*CompareFunc)(Pointer a, Pointer b);
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to function printing persistent tree's item
+typedef void (*PrintFunc)(Pointer);
+
+// pointer to a version of a persistent tree
+typedef struct persistent_tree *PersistentTree;
+
+/*-----Functions Provided-----*/
+/* Every PersistentTree is an immutable version of the tree. Updates return a new version, which shares all unchanged
+   nodes with the given one; both versions stay valid until destroyed. Versions can be read concurrently by many threads,
+   and destroying a version only frees the nodes that no other version uses.                                           */
+
+// initializes an empty persistent tree
+void ptree_initialize(PersistentTree *, CompareFunc, DestroyFunc, PrintFunc);
+
+// returns a new version of the tree that also holds given item
+// (if the item already exists, the new version is equal to the given one)
+PersistentTree ptree_insert(Pointer, PersistentTree);
+
+// returns a new version of the tree without given item
+// the item is destroyed when no version holds it anymore
+PersistentTree ptree_remove(Pointer, PersistentTree);
+
+// returns a new handle to the same version of the tree, in O(1)
+PersistentTree ptree_snapshot(PersistentTree);
+
+// prints items of the version
+void ptree_print(PersistentTree);
+
+// destroys the given version, freeing the nodes that aren't used by other versions
+void ptree_destroy(PersistentTree);
+
+// returns the number of elements in the version
+size_t ptree_size(PersistentTree);
+
+// returns true/false depending on if the version is empty or not
+bool ptree_is_empty(PersistentTree);
+
+// returns true/false based on if given item is found in the version or not
+bool ptree_search(Pointer, PersistentTree);
+
+// returns the element of the version that is equal to given item
+// returns NULL if not found
+Pointer ptree_find(Pointer, PersistentTree);
+
+// returns the element with lowest value
+Pointer ptree_min(PersistentTree);
+
+// returns the element with highest value
+Pointer ptree_max(PersistentTree);
+
+// sets as new DestroyFunc of given version the given one
+// (an item is destroyed with the DestroyFunc of the last version releasing it)
+void ptree_set_destroy(PersistentTree, DestroyFunc);
+
+// sets as new PrintFunc of given version the given one
+void ptree_set_print(PersistentTree, PrintFunc);
+
+#endif
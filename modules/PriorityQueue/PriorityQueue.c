@@ -3,21 +3,153 @@
 #include <assert.h>
 #include "PriorityQueue.h"
 
-// priority queue node struct
-typedef struct pq_node{
-    Pointer data; // pointer to the node data
-    struct pq_node *next; // pointer to the next priority queue node
-}pq_node;
+// initial capacity of the priority queue's array
+#define PQ_MIN_CAPACITY 16
 
 // priority queue struct
 struct priority_queue{
-    pq_node *head; // pointer to the first element in the priority queue
-    int size; // number of elements in the priority queue
+    Pointer *heap; // array of the items, stored as a min-max heap (heap[0] has the highest priority)
+    size_t size; // number of elements in the priority queue
+    size_t capacity; // number of items the array can hold
+    size_t bound; // max number of items kept in the priority queue (0 if unbounded)
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
     CompareFunc Compare;
     DestroyFunc Destroy;
     PrintFunc Print;
 };
 
+// heap functions
+/* The items are kept in a min-max heap: nodes on even levels have higher priority than all
+   their descendants and nodes on odd levels have lower priority than all their descendants.
+   Therefore both the highest priority item (heap[0]) and the lowest one (heap[1] or heap[2])
+   can be found in O(1), which lets a bounded priority queue reject or evict items quickly.  */
+
+// grows the array of given priority queue so that it can hold at least min_capacity items
+static void ensure_capacity(PriorityQueue pq, size_t min_capacity)
+{
+    if (min_capacity <= pq->capacity) return;
+    size_t new_capacity = pq->capacity ? pq->capacity : PQ_MIN_CAPACITY;
+    while (new_capacity < min_capacity) new_capacity *= 2;
+    pq->heap = realloc(pq->heap, new_capacity * sizeof(Pointer));
+    assert(pq->heap);
+    STATS_INC(pq, allocations);
+    pq->capacity = new_capacity;
+}
+
+// returns true if index i is on a min (even) level of the heap
+static bool is_min_level(size_t i)
+{
+    int level = 0;
+    for (size_t j = i + 1; j > 1; j >>= 1) level++;
+    return level % 2 == 0;
+}
+
+// returns true if a should be above b on a min level (or on a max level, if min is false)
+static bool precedes(PriorityQueue pq, Pointer a, Pointer b, bool min)
+{
+    STATS_INC(pq, comparisons);
+    int comp_result = pq->Compare(a, b);
+    return min ? comp_result < 0 : comp_result > 0;
+}
+
+// swaps the items at indexes i and j of the heap
+static void swap_items(PriorityQueue pq, size_t i, size_t j)
+{
+    Pointer temp = pq->heap[i];
+    pq->heap[i] = pq->heap[j];
+    pq->heap[j] = temp;
+}
+
+// moves the item at index i up through its grandparents, all on min (or max) levels
+static void bubble_up_level(PriorityQueue pq, size_t i, bool min)
+{
+    // nodes from index 3 and on have a grandparent
+    while (i > 2){
+        size_t grandparent = ((i - 1) / 2 - 1) / 2;
+        if (!precedes(pq, pq->heap[i], pq->heap[grandparent], min)) break;
+        swap_items(pq, i, grandparent);
+        i = grandparent;
+    }
+}
+
+// moves the newly placed item at index i up the heap
+static void bubble_up(PriorityQueue pq, size_t i)
+{
+    if (i == 0) return;
+    size_t parent = (i - 1) / 2;
+    bool min = is_min_level(i);
+    // if item belongs to the other kind of levels, swap it with its parent first
+    if (precedes(pq, pq->heap[parent], pq->heap[i], min)){
+        swap_items(pq, i, parent);
+        bubble_up_level(pq, parent, !min);
+    }
+    else bubble_up_level(pq, i, min);
+}
+
+// moves the item at index i down the heap, until the min-max heap property holds
+static void trickle_down(PriorityQueue pq, size_t i)
+{
+    bool min = is_min_level(i);
+    while (2 * i + 1 < pq->size){
+        // find the item that should come first among the children and grandchildren of i
+        size_t first_child = 2 * i + 1, first_grandchild = 4 * i + 3;
+        size_t m = first_child;
+        if (first_child + 1 < pq->size && precedes(pq, pq->heap[first_child + 1], pq->heap[m], min)) m = first_child + 1;
+        for (size_t g = first_grandchild; g < first_grandchild + 4 && g < pq->size; g++){
+            if (precedes(pq, pq->heap[g], pq->heap[m], min)) m = g;
+        }
+        if (!precedes(pq, pq->heap[m], pq->heap[i], min)) break;
+        swap_items(pq, i, m);
+        // a child of i has no descendants of i's kind; done
+        if (m < first_grandchild) break;
+        // the moved item may now have to swap places with its new parent
+        size_t parent = (m - 1) / 2;
+        if (precedes(pq, pq->heap[parent], pq->heap[m], min)) swap_items(pq, m, parent);
+        i = m;
+    }
+}
+
+// restores the heap property of the whole array in O(n) (Floyd's bottom-up heapify)
+static void heapify(PriorityQueue pq)
+{
+    for (size_t i = pq->size / 2; i > 0; i--) trickle_down(pq, i - 1);
+}
+
+// returns the index of the item with the lowest priority
+static size_t worst_index(PriorityQueue pq)
+{
+    if (pq->size <= 2) return pq->size - 1;
+    STATS_INC(pq, comparisons);
+    return pq->Compare(pq->heap[1], pq->heap[2]) >= 0 ? 1 : 2;
+}
+
+// removes the item at index i (the highest or lowest priority one) and returns it
+static Pointer remove_at(PriorityQueue pq, size_t i)
+{
+    Pointer item = pq->heap[i];
+    pq->size--;
+    STATS_INC(pq, removes);
+    // fill the empty place with the last item
+    if (i < pq->size){
+        pq->heap[i] = pq->heap[pq->size];
+        trickle_down(pq, i);
+    }
+    return item;
+}
+
+// places given item at the end of the heap and restores the heap property
+static void heap_push(Pointer item, PriorityQueue pq)
+{
+    ensure_capacity(pq, pq->size + 1);
+    pq->heap[pq->size] = item;
+    pq->size++;
+    STATS_INC(pq, inserts);
+    STATS_MAX(pq, peak_size, pq->size);
+    bubble_up(pq, pq->size - 1);
+}
+
 // Priority Queue ADT functions
 
 // initializes an empty priority queue
@@ -25,37 +157,86 @@ void pq_initialize(PriorityQueue *pq, CompareFunc compare_func, DestroyFunc dest
 {
     *pq = malloc(sizeof(struct priority_queue));
     assert(*pq);
-    (*pq)->head = NULL;
+    (*pq)->heap = NULL;
     (*pq)->size = 0;
+    (*pq)->capacity = 0;
+    (*pq)->bound = 0;
+    pq_reset_stats(*pq);
     pq_set_compare(*pq, compare_func);
     pq_set_destroy(*pq, destroy_func);
     pq_set_print(*pq, print_func);
 }
 
+// initializes a priority queue holding the n given items, built in O(n)
+void pq_initialize_from_array(PriorityQueue *pq, Pointer *items, size_t n, CompareFunc compare_func, DestroyFunc destroy_func, PrintFunc print_func)
+{
+    pq_initialize(pq, compare_func, destroy_func, print_func);
+    pq_insert_many(items, n, *pq);
+}
+
+// initializes an empty priority queue that keeps at most bound items with the highest priority
+void pq_initialize_bounded(PriorityQueue *pq, size_t bound, CompareFunc compare_func, DestroyFunc destroy_func, PrintFunc print_func)
+{
+    pq_initialize(pq, compare_func, destroy_func, print_func);
+    (*pq)->bound = bound;
+}
+
 // inserts a new item in the priority queue, based on its priority
-void pq_insert(Pointer item, PriorityQueue pq)
-{
-    // if a CompareFunc doesn't exist; return
-    if (pq->Compare == NULL) return;
-
-    pq_node *new_node = malloc(sizeof(pq_node));
-    assert(new_node);
-    new_node->data = item;
-    // check if item should be inserted at the start of the pq
-    if (pq_is_empty(pq) || pq->Compare(new_node->data, pq->head->data) <= 0){
-        new_node->next = pq->head;
-        pq->head = new_node;
-        pq->size++;
-        return;
+// if the priority queue is bounded and full, the item with the lowest priority (the given one or the worst kept one)
+// is dropped and returned, without being destroyed; returns NULL if no item is dropped
+Pointer pq_insert(Pointer item, PriorityQueue pq)
+{
+    // if a CompareFunc doesn't exist; the item isn't inserted
+    if (pq->Compare == NULL) return item;
+
+    // check if pq is bounded and full
+    if (pq->bound && pq->size >= pq->bound){
+        size_t worst = worst_index(pq);
+        // reject item if it doesn't have higher priority than the worst kept item
+        STATS_INC(pq, comparisons);
+        if (pq->Compare(item, pq->heap[worst]) >= 0) return item;
+        // else; evict the worst item
+        Pointer evicted = remove_at(pq, worst);
+        heap_push(item, pq);
+        return evicted;
     }
-    // else; find where new_node should be placed
-    pq_node *temp = pq->head;
-    while(temp->next != NULL && pq->Compare(new_node->data, temp->next->data) > 0){
-        temp = temp->next;
+    heap_push(item, pq);
+    return NULL;
+}
+
+// inserts the n given items in the priority queue
+// the items dropped by a bounded priority queue are moved to the start of the array; returns their number
+size_t pq_insert_many(Pointer *items, size_t n, PriorityQueue pq)
+{
+    // if a CompareFunc doesn't exist; none of the items is inserted
+    if (pq->Compare == NULL) return n;
+    if (!n) return 0;
+
+    // a bounded pq only heapifies the items that fit; the rest compete through pq_insert
+    if (pq->bound){
+        size_t fit = pq->size < pq->bound ? pq->bound - pq->size : 0;
+        if (fit < n){
+            pq_insert_many(items, fit, pq);
+            // at most i - fit + 1 items are dropped by the first i + 1 inserts, so no item is overwritten before it's read
+            size_t dropped = 0;
+            for (size_t i = fit; i < n; i++){
+                Pointer out = pq_insert(items[i], pq);
+                if (out != NULL) items[dropped++] = out;
+            }
+            return dropped;
+        }
     }
-    new_node->next = temp->next;
-    temp->next = new_node;
-    pq->size++;
+
+    ensure_capacity(pq, pq->size + n);
+    size_t old_size = pq->size;
+    for (size_t i = 0; i < n; i++) pq->heap[old_size + i] = items[i];
+    pq->size += n;
+    STATS_ADD(pq, inserts, n);
+    STATS_MAX(pq, peak_size, pq->size);
+    // a batch comparable to the current size is cheaper to heapify as a whole
+    if (n >= old_size) heapify(pq);
+    else for (size_t i = old_size; i < pq->size; i++) bubble_up(pq, i);
+    return 0;
 }
 
 // removes and returns the item with highest priority from the priority queue
@@ -65,54 +246,81 @@ Pointer pq_remove(PriorityQueue pq)
     // check if pq is empty
     if (pq_is_empty(pq)) return NULL;
     // else; remove the item with highest priority
-    Pointer item = pq->head->data;
-    pq_node *new_head = pq->head->next;
-    free(pq->head);
-    pq->size--;
-    pq->head = new_head;
-    return item;
+    return remove_at(pq, 0);
+}
+
+// removes up to k items with highest priority and stores them in out, in priority order
+// returns the number of removed items
+size_t pq_remove_many(Pointer *out, size_t k, PriorityQueue pq)
+{
+    size_t removed = 0;
+    while (removed < k && !pq_is_empty(pq)) out[removed++] = pq_remove(pq);
+    return removed;
+}
+
+// returns the item with lowest priority without removing it
+// returns NULL if priority queue is empty
+Pointer pq_worst(PriorityQueue pq)
+{
+    if (pq_is_empty(pq)) return NULL;
+    return pq->heap[worst_index(pq)];
+}
+
+// visits the items of the priority queue in heap order with given VisitFunc, until a visit returns false
+void pq_for_each(PriorityQueue pq, VisitFunc visit, void *context)
+{
+    for (size_t i = 0; i < pq->size; i++){
+        if (!visit(pq->heap[i], context)) return;
+    }
+}
+
+// initializes given iterator at the first item of the heap
+void pq_iterator_init(PQIterator *it, PriorityQueue pq)
+{
+    it->pq = pq;
+    it->index = 0;
 }
 
-// prints items of the priority queue based on given PrintFunc
+// returns the next item of the iterator, or NULL after the last one
+Pointer pq_iterator_next(PQIterator *it)
+{
+    if (it->index >= it->pq->size) return NULL;
+    return it->pq->heap[it->index++];
+}
+
+// prints items of the priority queue based on given PrintFunc, in heap (array) order
 void pq_print(PriorityQueue pq)
 {
     // check if a PrintFunc exists and pq isn't empty
     if (pq->Print == NULL || pq_is_empty(pq)) return;
-    // else; print pq's elements 
-    pq_node *node = pq->head;
-    while (node != NULL){
-        pq->Print(node->data);
-        node = node->next;
-    }
+    // else; print pq's elements
+    for (size_t i = 0; i < pq->size; i++) pq->Print(pq->heap[i]);
     printf("\n");
 }
 
 // destroys the given priority queue
 void pq_destroy(PriorityQueue pq)
 {
-    // check if pq is empty
-    if (pq_is_empty(pq)){
-        free(pq);
-        return;
-    }
-    // else; destroy pq's elements 
-    pq_node *node = pq->head->next;
-    while (!pq_is_empty(pq)){
-        if (pq->Destroy != NULL) pq->Destroy(pq->head->data);
-        free(pq->head);
-        pq->head = node;
-        if (node != NULL) node = node->next;
-        pq->size--;
+    // destroy pq's elements
+    if (pq->Destroy != NULL){
+        for (size_t i = 0; i < pq->size; i++) pq->Destroy(pq->heap[i]);
     }
+    free(pq->heap);
     free(pq);
 }
 
 // returns the number of elements in the priority queue
-int pq_size(PriorityQueue pq)
+size_t pq_size(PriorityQueue pq)
 {
     return pq->size;
 }
 
+// returns the max number of items kept in the priority queue (0 if unbounded)
+size_t pq_bound(PriorityQueue pq)
+{
+    return pq->bound;
+}
+
 // returns true/false depending on if priority queue is empty or not
 bool pq_is_empty(PriorityQueue pq)
 {
@@ -120,6 +328,27 @@ bool pq_is_empty(PriorityQueue pq)
     else return false;
 }
 
+// returns the operation counters of the priority queue
+AdtStats pq_get_stats(PriorityQueue pq)
+{
+#ifdef ADT_STATS
+    return pq->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the priority queue; the peak size becomes the current size
+void pq_reset_stats(PriorityQueue pq)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = pq->size;
+    pq->stats = stats;
+#endif
+}
+
 // sets as new CompareFunc of given priority the given one
 void pq_set_compare(PriorityQueue pq, CompareFunc compare_func)
 {
@@ -136,4 +365,4 @@ void pq_set_destroy(PriorityQueue pq, DestroyFunc destroy_func)
 void pq_set_print(PriorityQueue pq, PrintFunc print_func)
 {
     pq->Print = print_func;
-}
\ No newline at end of file
+}
@@ -4,6 +4,9 @@
 #define PRIORITY_QUEUE_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+#include "../Iterators/Iterators.h"
 
 // generic-pointer typedef
 typedef void *Pointer;
@@ -20,33 +23,83 @@ typedef void (*DestroyFunc)(Pointer);
 // pointer to function printing priority queue's item
 typedef void (*PrintFunc)(Pointer);
 
+// pointer to function that visits given element, with the context given to the visiting function
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
 // pointer to priority queue
 typedef struct priority_queue *PriorityQueue;
 
+// iterator over the items of a priority queue (PQIterator, defined in Iterators.h), in heap order (not sorted)
+// declared by the user (usually as a local variable); it stays valid as long as the priority queue isn't changed
+
 /*-----Functions Provided-----*/
 
 // initializes an empty priority queue
 void pq_initialize(PriorityQueue *, CompareFunc, DestroyFunc, PrintFunc);
 
+// initializes a priority queue holding the n items of given array, in O(n)
+void pq_initialize_from_array(PriorityQueue *, Pointer *items, size_t n, CompareFunc, DestroyFunc, PrintFunc);
+
+// initializes an empty priority queue that keeps at most bound items (the ones with highest priority)
+void pq_initialize_bounded(PriorityQueue *, size_t bound, CompareFunc, DestroyFunc, PrintFunc);
+
 // inserts a new item in priority queue
-void pq_insert(Pointer, PriorityQueue);
+// if the priority queue is bounded and full, the item is rejected if it doesn't have higher priority
+// than the lowest priority item; else that item is evicted
+// returns the rejected or evicted item, which is not destroyed but stays the caller's, or NULL if no item is dropped
+// (the given item is also returned, not inserted, if there is no CompareFunc)
+Pointer pq_insert(Pointer, PriorityQueue);
+
+// inserts the n items of given array in priority queue
+// large batches are inserted with a bottom-up heapify, in O(size + n)
+// the items rejected or evicted by a bounded priority queue are moved to the start of the array and stay the caller's
+// returns their number (n if there is no CompareFunc)
+size_t pq_insert_many(Pointer *items, size_t n, PriorityQueue);
 
 // removes and returns the item with highest priority
 // returns NULL if priority queue is empty
 Pointer pq_remove(PriorityQueue);
 
-// prints items of the priority queue
+// removes up to k items with highest priority and stores them in out, in priority order
+// returns the number of removed items
+size_t pq_remove_many(Pointer *out, size_t k, PriorityQueue);
+
+// returns the item with lowest priority, without removing it
+// returns NULL if priority queue is empty
+Pointer pq_worst(PriorityQueue);
+
+// visits the items of the priority queue in heap order (not sorted) with given VisitFunc and context
+// stops once a visit returns false
+void pq_for_each(PriorityQueue, VisitFunc, void *context);
+
+// initializes given iterator at the first item of the priority queue (the one with the highest priority)
+void pq_iterator_init(PQIterator *, PriorityQueue);
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer pq_iterator_next(PQIterator *);
+
+// prints items of the priority queue (in heap order, not sorted)
 void pq_print(PriorityQueue);
 
 // destroys the given priority queue by freeing all nodes
 void pq_destroy(PriorityQueue);
 
 // returns the number of elements in the priority queue
-int pq_size(PriorityQueue);
+size_t pq_size(PriorityQueue);
+
+// returns the max number of items kept in the priority queue (0 if unbounded)
+size_t pq_bound(PriorityQueue);
 
 // returns true/false depending on if priority queue is empty or not
 bool pq_is_empty(PriorityQueue);
 
+// returns the operation counters of the priority queue (see Stats.h)
+AdtStats pq_get_stats(PriorityQueue);
+
+// resets the operation counters of the priority queue
+void pq_reset_stats(PriorityQueue);
+
 // sets as new CompareFunc of given priority queue the given one
 void pq_set_compare(PriorityQueue, CompareFunc);
 
@@ -3,17 +3,29 @@
 #include <assert.h>
 #include "Queue.h"
 
-// queue node struct
-typedef struct queue_node{
-    Pointer data; // pointer to the node data
-    struct queue_node *next; // pointer to the next queue node
-}queue_node;
+// number of items held by every block of the queue
+#define QUEUE_BLOCK_ITEMS 32
+
+// queue block struct
+typedef struct queue_block{
+    Pointer items[QUEUE_BLOCK_ITEMS]; // items of the block
+    int start, end; // the items of the block are items[start] to items[end - 1]
+    struct queue_block *next; // pointer to the next queue block
+}queue_block;
 
 // queue struct
+/* The items are kept in an unrolled linked list: every block holds up to QUEUE_BLOCK_ITEMS items, inserted at the
+   end of the rear block and removed from the start of the front block. So a block is allocated or freed only once
+   every QUEUE_BLOCK_ITEMS operations, and traversals read consecutive items instead of following a pointer for each
+   one. Every block keeps its own start and end, so the blocks of two queues can be concatenated without moving
+   any items, and no block other than the front one is ever empty.                                             */
 struct queue{
-    queue_node *front; // pointer to the first/front queue element
-    queue_node *rear; // pointer to the last/rear queue element
-    int size; // number of elements in the queue
+    queue_block *front; // pointer to the front block of the queue (NULL if the queue has no blocks)
+    queue_block *rear; // pointer to the rear block of the queue
+    size_t size; // number of elements in the queue
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
     DestroyFunc Destroy;
     PrintFunc Print;
 };
@@ -28,6 +40,7 @@ void queue_initialize(Queue *q, DestroyFunc destroy_func, PrintFunc print_func)
     (*q)->front = NULL;
     (*q)->rear = NULL;
     (*q)->size = 0;
+    queue_reset_stats(*q);
     queue_set_destroy(*q, destroy_func);
     queue_set_print(*q, print_func);
 }
@@ -35,20 +48,22 @@ void queue_initialize(Queue *q, DestroyFunc destroy_func, PrintFunc print_func)
 // inserts a new item at the end of the queue
 void queue_insert(Pointer item, Queue q)
 {
-    queue_node *new_node = malloc(sizeof(queue_node));
-    assert(new_node);
-    new_node->data = item;
-    new_node->next = NULL;
-    // check if queue is empty
-    if (queue_is_empty(q)){
-        q->front = new_node;
-        q->rear = new_node;
-        q->size++;
-        return;
+    // check if the rear block is full; a new block is linked after it
+    if (q->rear == NULL || q->rear->end == QUEUE_BLOCK_ITEMS){
+        queue_block *block = malloc(sizeof(queue_block));
+        assert(block);
+        block->start = 0;
+        block->end = 0;
+        block->next = NULL;
+        STATS_INC(q, allocations);
+        if (q->rear == NULL) q->front = block;
+        else q->rear->next = block;
+        q->rear = block;
     }
-    q->rear->next = new_node;
-    q->rear = new_node;
+    q->rear->items[q->rear->end++] = item;
     q->size++;
+    STATS_INC(q, inserts);
+    STATS_MAX(q, peak_size, q->size);
 }
 
 // removes and returns the item from the start of the queue
@@ -58,11 +73,73 @@ Pointer queue_remove(Queue q)
     // check if queue is empty
     if (queue_is_empty(q)) return NULL;
     // else; remove the front element of the queue
-    Pointer item = q->front->data;
-    queue_node *new_front = q->front->next;
-    free(q->front);
+    queue_block *block = q->front;
+    Pointer item = block->items[block->start++];
     q->size--;
-    q->front = new_front;
+    STATS_INC(q, removes);
+    if (block->start == block->end){
+        // the last block of the queue is kept and reused from its start; any other emptied block is freed
+        if (block->next == NULL) block->start = block->end = 0;
+        else{
+            q->front = block->next;
+            free(block);
+            STATS_INC(q, frees);
+        }
+    }
+    return item;
+}
+
+// moves all items of queue src to the end of queue dst, in O(1) without allocating any blocks or moving any items
+// src is left empty
+void queue_concat(Queue dst, Queue src)
+{
+    if (dst == src || queue_is_empty(src)) return;
+    // an empty dst only has an empty block (if any), which is replaced by the blocks of src
+    if (queue_is_empty(dst)){
+        if (dst->front != NULL){
+            free(dst->front);
+            STATS_INC(dst, frees);
+        }
+        dst->front = src->front;
+    }
+    else dst->rear->next = src->front;
+    dst->rear = src->rear;
+    dst->size += src->size;
+    STATS_ADD(dst, inserts, src->size);
+    STATS_ADD(src, removes, src->size);
+    STATS_MAX(dst, peak_size, dst->size);
+    src->front = NULL;
+    src->rear = NULL;
+    src->size = 0;
+}
+
+// visits the items of the queue from the front to the rear with given VisitFunc, until a visit returns false
+void queue_for_each(Queue q, VisitFunc visit, void *context)
+{
+    for (queue_block *block = q->front; block != NULL; block = block->next){
+        for (int i = block->start; i < block->end; i++){
+            if (!visit(block->items[i], context)) return;
+        }
+    }
+}
+
+// initializes given iterator at the front of the queue
+void queue_iterator_init(QueueIterator *it, Queue q)
+{
+    it->block = queue_is_empty(q) ? NULL : q->front;
+    it->index = it->block != NULL ? it->block->start : 0;
+}
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer queue_iterator_next(QueueIterator *it)
+{
+    if (it->block == NULL) return NULL;
+    Pointer item = it->block->items[it->index++];
+    // move to the start of the next block, if this one is done
+    if (it->index == it->block->end){
+        it->block = it->block->next;
+        if (it->block != NULL) it->index = it->block->start;
+    }
     return item;
 }
 
@@ -71,11 +148,9 @@ void queue_print(Queue q)
 {
     // check if a PrintFunc exists and if queue isn't empty
     if (q->Print == NULL || queue_is_empty(q)) return;
-    // else; print pq's elements 
-    queue_node *node = q->front;
-    while (node != NULL){
-        q->Print(node->data);
-        node = node->next;
+    // else; print queue's elements 
+    for (queue_block *block = q->front; block != NULL; block = block->next){
+        for (int i = block->start; i < block->end; i++) q->Print(block->items[i]);
     }
     printf("\n");
 }
@@ -83,25 +158,21 @@ void queue_print(Queue q)
 // destroys the given queue
 void queue_destroy(Queue q)
 {
-    // check if queue is empty
-    if (queue_is_empty(q)){
-        free(q);
-        return;
-    }
-    // else; destroy pq's elements 
-    queue_node *node = q->front->next;
-    while (!queue_is_empty(q)){
-        if (q->Destroy != NULL) q->Destroy(q->front->data);
-        free(q->front);
-        q->front = node;
-        if (node != NULL) node = node->next;
-        q->size--;
+    // destroy queue's elements and blocks
+    queue_block *block = q->front;
+    while (block != NULL){
+        queue_block *next = block->next;
+        if (q->Destroy != NULL){
+            for (int i = block->start; i < block->end; i++) q->Destroy(block->items[i]);
+        }
+        free(block);
+        block = next;
     }
     free(q);
 }
 
 // returns the number of elements in the queue
-int queue_size(Queue q)
+size_t queue_size(Queue q)
 {
     return q->size;
 }
@@ -118,7 +189,7 @@ bool queue_is_empty(Queue q)
 Pointer queue_front(Queue q)
 {
     if (queue_is_empty(q)) return NULL;
-    return q->front->data;
+    return q->front->items[q->front->start];
 }
 
 // returns the rear element of the queue
@@ -126,7 +197,28 @@ Pointer queue_front(Queue q)
 Pointer queue_rear(Queue q)
 {
     if (queue_is_empty(q)) return NULL;
-    return q->rear->data;
+    return q->rear->items[q->rear->end - 1];
+}
+
+// returns the operation counters of the queue
+AdtStats queue_get_stats(Queue q)
+{
+#ifdef ADT_STATS
+    return q->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the queue; the peak size becomes the current size
+void queue_reset_stats(Queue q)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = q->size;
+    q->stats = stats;
+#endif
 }
 
 // sets as new DestroyFunc of given queue the given one
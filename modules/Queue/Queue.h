@@ -4,6 +4,9 @@
 #define QUEUE_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+#include "../Iterators/Iterators.h"
 
 // generic-pointer typedef
 typedef void *Pointer;
@@ -14,9 +17,16 @@ typedef void (*DestroyFunc)(Pointer);
 // pointer to function printing queue's item
 typedef void (*PrintFunc)(Pointer);
 
+// pointer to function that visits given element, with the context given to the visiting function
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
 // pointer to queue
 typedef struct queue *Queue;
 
+// iterator over the items of a queue (QueueIterator, defined in Iterators.h), from the front to the rear
+// declared by the user (usually as a local variable); it stays valid as long as the queue isn't changed
+
 /*-----Functions Provided-----*/
 
 // initializes an empty queue
@@ -29,6 +39,19 @@ void queue_insert(Pointer, Queue);
 // returns NULL if queue is empty
 Pointer queue_remove(Queue);
 
+// moves all items of src to the end of dst in O(1); src is left empty
+void queue_concat(Queue dst, Queue src);
+
+// visits the items of the queue from the front to the rear with given VisitFunc and context
+// stops once a visit returns false
+void queue_for_each(Queue, VisitFunc, void *context);
+
+// initializes given iterator at the front of the queue
+void queue_iterator_init(QueueIterator *, Queue);
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer queue_iterator_next(QueueIterator *);
+
 // prints items of the queue
 void queue_print(Queue);
 
@@ -36,7 +59,7 @@ void queue_print(Queue);
 void queue_destroy(Queue);
 
 // returns the number of elements in the queue
-int queue_size(Queue);
+size_t queue_size(Queue);
 
 // returns true/false depending on if queue is empty or not
 bool queue_is_empty(Queue);
@@ -47,6 +70,12 @@ Pointer queue_front(Queue);
 // returns the element at the end of the queue
 Pointer queue_rear(Queue);
 
+// returns the operation counters of the queue (see Stats.h)
+AdtStats queue_get_stats(Queue);
+
+// resets the operation counters of the queue
+void queue_reset_stats(Queue);
+
 // sets as new DestroyFunc of given queue the given one
 void queue_set_destroy(Queue, DestroyFunc);
 
@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <assert.h>
+#include "RadixHeap.h"
+
+// number of bits of a key
+#define KEY_BITS (sizeof(unsigned long) * CHAR_BIT)
+
+// initial capacity of a bucket's array
+#define BUCKET_MIN_CAPACITY 8
+
+#ifdef __GNUC__
+#define SIGNIFICANT_BITS(x) (KEY_BITS - __builtin_clzl(x))
+#else
+// returns the number of bits of x up to its most significant set bit (x must not be 0)
+static size_t SIGNIFICANT_BITS(unsigned long x)
+{
+    size_t bits = 0;
+    while (x){
+        bits++;
+        x >>= 1;
+    }
+    return bits;
+}
+#endif
+
+// radix heap entry struct
+typedef struct rh_entry{
+    unsigned long key; // the key of the item, as returned by the KeyFunc
+    Pointer data; // pointer to the entry data
+}rh_entry;
+
+// radix heap bucket struct
+typedef struct rh_bucket{
+    rh_entry *entries; // array of the bucket's entries (in no particular order)
+    size_t size; // number of entries in the bucket
+    size_t capacity; // number of entries the array can hold
+}rh_bucket;
+
+// radix heap struct
+/* Bucket 0 holds the items whose key equals last, and bucket i (i > 0) the items whose key
+   differs from last first at bit i-1 (counting from the least significant bit). */
+struct radix_heap{
+    rh_bucket buckets[KEY_BITS + 1]; // buckets of the radix heap
+    unsigned long last; // key of the last removed item
+    size_t size; // number of elements in the radix heap
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
+    KeyFunc Key;
+    DestroyFunc Destroy;
+    PrintFunc Print;
+};
+
+// bucket functions
+
+// returns the bucket in which an item with given key belongs, given the key of the last removed item
+static size_t bucket_index(unsigned long key, unsigned long last)
+{
+    unsigned long diff = key ^ last;
+    return diff ? SIGNIFICANT_BITS(diff) : 0;
+}
+
+// appends an entry to given bucket of the radix heap
+static void bucket_push(RadixHeap rh, rh_bucket *bucket, unsigned long key, Pointer item)
+{
+    if (bucket->size == bucket->capacity){
+        bucket->capacity = bucket->capacity ? 2 * bucket->capacity : BUCKET_MIN_CAPACITY;
+        bucket->entries = realloc(bucket->entries, bucket->capacity * sizeof(rh_entry));
+        assert(bucket->entries);
+        STATS_INC(rh, allocations);
+    }
+    bucket->entries[bucket->size].key = key;
+    bucket->entries[bucket->size].data = item;
+    bucket->size++;
+}
+
+// fills bucket 0 by redistributing the first non-empty bucket around its smallest key
+static void refill_first_bucket(RadixHeap rh)
+{
+    size_t i = 1;
+    while (!rh->buckets[i].size) i++;
+    rh_bucket *bucket = &rh->buckets[i];
+    // the smallest key of the bucket becomes the new last key
+    unsigned long min = bucket->entries[0].key;
+    for (size_t j = 1; j < bucket->size; j++){
+        if (bucket->entries[j].key < min) min = bucket->entries[j].key;
+    }
+    rh->last = min;
+    // every entry moves to a bucket with a smaller index
+    for (size_t j = 0; j < bucket->size; j++){
+        rh_entry *entry = &bucket->entries[j];
+        bucket_push(rh, &rh->buckets[bucket_index(entry->key, min)], entry->key, entry->data);
+    }
+    bucket->size = 0;
+}
+
+// Radix Heap ADT functions
+
+// initializes an empty radix heap
+void rh_initialize(RadixHeap *rh, KeyFunc key_func, DestroyFunc destroy_func, PrintFunc print_func)
+{
+    *rh = malloc(sizeof(struct radix_heap));
+    assert(*rh);
+    for (size_t i = 0; i <= KEY_BITS; i++){
+        (*rh)->buckets[i].entries = NULL;
+        (*rh)->buckets[i].size = 0;
+        (*rh)->buckets[i].capacity = 0;
+    }
+    (*rh)->last = 0;
+    (*rh)->size = 0;
+    rh_reset_stats(*rh);
+    rh_set_key(*rh, key_func);
+    rh_set_destroy(*rh, destroy_func);
+    rh_set_print(*rh, print_func);
+}
+
+// inserts a new item in the radix heap, in the bucket of its key
+// returns false if there is no KeyFunc or the key is smaller than the last removed key
+bool rh_insert(Pointer item, RadixHeap rh)
+{
+    // if a KeyFunc doesn't exist; the item can't be placed
+    if (rh->Key == NULL) return false;
+    unsigned long key = rh->Key(item);
+    // keys smaller than the last removed one break the monotonicity of the heap; reject them
+    if (key < rh->last) return false;
+    bucket_push(rh, &rh->buckets[bucket_index(key, rh->last)], key, item);
+    rh->size++;
+    STATS_INC(rh, inserts);
+    STATS_MAX(rh, peak_size, rh->size);
+    return true;
+}
+
+// removes and returns the item with the smallest key from the radix heap
+// returns NULL if radix heap is empty
+Pointer rh_remove(RadixHeap rh)
+{
+    // check if radix heap is empty
+    if (rh_is_empty(rh)) return NULL;
+    // else; make sure bucket 0 has the items with the smallest key and remove one of them
+    if (!rh->buckets[0].size) refill_first_bucket(rh);
+    rh->buckets[0].size--;
+    rh->size--;
+    STATS_INC(rh, removes);
+    return rh->buckets[0].entries[rh->buckets[0].size].data;
+}
+
+// returns the key of the last removed item
+unsigned long rh_last_key(RadixHeap rh)
+{
+    return rh->last;
+}
+
+// prints items of the radix heap based on given PrintFunc, bucket by bucket
+void rh_print(RadixHeap rh)
+{
+    // check if a PrintFunc exists and radix heap isn't empty
+    if (rh->Print == NULL || rh_is_empty(rh)) return;
+    // else; print radix heap's elements
+    for (size_t i = 0; i <= KEY_BITS; i++){
+        for (size_t j = 0; j < rh->buckets[i].size; j++) rh->Print(rh->buckets[i].entries[j].data);
+    }
+    printf("\n");
+}
+
+// destroys the given radix heap
+void rh_destroy(RadixHeap rh)
+{
+    for (size_t i = 0; i <= KEY_BITS; i++){
+        if (rh->Destroy != NULL){
+            for (size_t j = 0; j < rh->buckets[i].size; j++) rh->Destroy(rh->buckets[i].entries[j].data);
+        }
+        free(rh->buckets[i].entries);
+    }
+    free(rh);
+}
+
+// returns the number of elements in the radix heap
+size_t rh_size(RadixHeap rh)
+{
+    return rh->size;
+}
+
+// returns true/false depending on if radix heap is empty or not
+bool rh_is_empty(RadixHeap rh)
+{
+    if (!rh_size(rh)) return true;
+    else return false;
+}
+
+// returns the operation counters of the radix heap
+AdtStats rh_get_stats(RadixHeap rh)
+{
+#ifdef ADT_STATS
+    return rh->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the radix heap; the peak size becomes the current size
+void rh_reset_stats(RadixHeap rh)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = rh->size;
+    rh->stats = stats;
+#endif
+}
+
+// sets as new KeyFunc of given radix heap the given one
+void rh_set_key(RadixHeap rh, KeyFunc key_func)
+{
+    rh->Key = key_func;
+}
+
+// sets as new DestroyFunc of given radix heap the given one
+void rh_set_destroy(RadixHeap rh, DestroyFunc destroy_func)
+{
+    rh->Destroy = destroy_func;
+}
+
+// sets as new PrintFunc of given radix heap the given one
+void rh_set_print(RadixHeap rh, PrintFunc print_func)
+{
+    rh->Print = print_func;
+}
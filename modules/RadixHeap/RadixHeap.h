@@ -0,0 +1,70 @@
+/* Interface file of Radix Heap ADT */
+
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+// pointer to function that returns the (unsigned integer) key of given element
+// elements with smaller keys have higher priority
+typedef unsigned long (*KeyFunc)(Pointer);
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to function printing radix heap's item
+typedef void (*PrintFunc)(Pointer);
+
+// pointer to radix heap
+typedef struct radix_heap *RadixHeap;
+
+/*-----Functions Provided-----*/
+
+// initializes an empty radix heap
+void rh_initialize(RadixHeap *, KeyFunc, DestroyFunc, PrintFunc);
+
+// inserts a new item in radix heap
+// the heap is monotone: an item with a key smaller than the key of the last removed item is not inserted
+// returns false if the item is not inserted (its key is too small, or there is no KeyFunc); it then stays the caller's
+bool rh_insert(Pointer, RadixHeap);
+
+// removes and returns the item with the smallest key
+// returns NULL if radix heap is empty
+Pointer rh_remove(RadixHeap);
+
+// returns the key of the last removed item (0 if no item was removed yet)
+unsigned long rh_last_key(RadixHeap);
+
+// prints items of the radix heap
+void rh_print(RadixHeap);
+
+// destroys the given radix heap by freeing all buckets
+void rh_destroy(RadixHeap);
+
+// returns the number of elements in the radix heap
+size_t rh_size(RadixHeap);
+
+// returns true/false depending on if radix heap is empty or not
+bool rh_is_empty(RadixHeap);
+
+// returns the operation counters of the radix heap (see Stats.h)
+AdtStats rh_get_stats(RadixHeap);
+
+// resets the operation counters of the radix heap
+void rh_reset_stats(RadixHeap);
+
+// sets as new KeyFunc of given radix heap the given one
+void rh_set_key(RadixHeap, KeyFunc);
+
+// sets as new DestroyFunc of given radix heap the given one
+void rh_set_destroy(RadixHeap, DestroyFunc);
+
+// sets as new PrintFunc of given radix heap the given one
+void rh_set_print(RadixHeap, PrintFunc);
+
+#endif
@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <assert.h>
+#include "ReadMostlyTree.h"
+#include "../PersistentTree/PersistentTree.h"
+#include "../Epoch/Epoch.h"
+
+// read-mostly tree struct
+/* Read-copy-update over a persistent red black tree: the current version of the tree is published through an
+   atomic pointer. A read loads the current version inside a critical section of the tree's epoch domain and
+   searches it without any locks, since versions never change. An update takes the writer mutex, creates the
+   next version (copying only the path to the changed node), publishes it, and retires the previous version to
+   the epoch domain, which destroys it once the reads that loaded it are over; destroying a version frees only
+   the nodes (and items) that the newer versions don't share. A mutable red black tree can't be read this way:
+   its rotations and removals change and free nodes in place, under the feet of the readers.                */
+struct read_mostly_tree{
+    _Atomic(PersistentTree) current; // the current version, read by every read
+    char padding[64 - sizeof(PersistentTree)]; // keeps the writer mutex out of the cache line of the current version
+    pthread_mutex_t writer; // serializes the updates
+    EpochDomain epoch; // epoch domain of the reads, where previous versions are retired
+    bool owns_epoch; // true if the domain was created for the tree, and is destroyed with it
+};
+
+// version functions
+
+// DestroyFunc of the retired versions
+static void destroy_version(Pointer version)
+{
+    ptree_destroy(version);
+}
+
+// replaces the current version with given one and retires the previous one
+// the writer mutex must be held, and is released
+static void publish(PersistentTree version, ReadMostlyTree rmt)
+{
+    PersistentTree previous = atomic_load_explicit(&rmt->current, memory_order_relaxed);
+    atomic_store_explicit(&rmt->current, version, memory_order_release);
+    pthread_mutex_unlock(&rmt->writer);
+    ep_retire(previous, destroy_version, rmt->epoch);
+}
+
+// starts a read: enters a critical section and returns the current version
+static PersistentTree read_version(ReadMostlyTree rmt)
+{
+    ep_enter(rmt->epoch);
+    return atomic_load_explicit(&rmt->current, memory_order_acquire);
+}
+
+// Read-Mostly Tree ADT functions
+
+// initializes an empty read-mostly tree, with an epoch domain of its own
+// returns false if the domain can't be created; the tree is then NULL
+bool rmt_initialize(ReadMostlyTree *rmt, CompareFunc compare, DestroyFunc destroy, PrintFunc print)
+{
+    EpochDomain epoch;
+    if (!ep_initialize(&epoch)){
+        *rmt = NULL;
+        return false;
+    }
+    rmt_initialize_shared(rmt, epoch, compare, destroy, print);
+    (*rmt)->owns_epoch = true;
+    return true;
+}
+
+// initializes an empty read-mostly tree that retires its previous versions to given epoch domain
+void rmt_initialize_shared(ReadMostlyTree *rmt, EpochDomain epoch, CompareFunc compare, DestroyFunc destroy, PrintFunc print)
+{
+    *rmt = malloc(sizeof(struct read_mostly_tree));
+    assert(*rmt);
+    PersistentTree version;
+    ptree_initialize(&version, compare, destroy, print);
+    atomic_init(&(*rmt)->current, version);
+    pthread_mutex_init(&(*rmt)->writer, NULL);
+    (*rmt)->epoch = epoch;
+    (*rmt)->owns_epoch = false;
+}
+
+// inserts given item in the tree
+// returns false if an equal item is already in the tree
+bool rmt_insert(Pointer item, ReadMostlyTree rmt)
+{
+    pthread_mutex_lock(&rmt->writer);
+    PersistentTree current = atomic_load_explicit(&rmt->current, memory_order_relaxed);
+    if (ptree_search(item, current)){
+        pthread_mutex_unlock(&rmt->writer);
+        return false;
+    }
+    publish(ptree_insert(item, current), rmt);
+    return true;
+}
+
+// removes given item from the tree
+// returns false if there is no equal item in the tree
+bool rmt_remove(Pointer item, ReadMostlyTree rmt)
+{
+    pthread_mutex_lock(&rmt->writer);
+    PersistentTree current = atomic_load_explicit(&rmt->current, memory_order_relaxed);
+    if (!ptree_search(item, current)){
+        pthread_mutex_unlock(&rmt->writer);
+        return false;
+    }
+    publish(ptree_remove(item, current), rmt);
+    return true;
+}
+
+// returns true/false based on if given item is found in the tree or not
+bool rmt_search(Pointer item, ReadMostlyTree rmt)
+{
+    bool found = ptree_search(item, read_version(rmt));
+    ep_exit(rmt->epoch);
+    return found;
+}
+
+// returns the element of the tree that is equal to given item, or NULL if not found
+Pointer rmt_find(Pointer item, ReadMostlyTree rmt)
+{
+    Pointer found = ptree_find(item, read_version(rmt));
+    ep_exit(rmt->epoch);
+    return found;
+}
+
+// returns the element with lowest value
+Pointer rmt_min(ReadMostlyTree rmt)
+{
+    Pointer min = ptree_min(read_version(rmt));
+    ep_exit(rmt->epoch);
+    return min;
+}
+
+// returns the element with highest value
+Pointer rmt_max(ReadMostlyTree rmt)
+{
+    Pointer max = ptree_max(read_version(rmt));
+    ep_exit(rmt->epoch);
+    return max;
+}
+
+// returns the current version of the tree
+PersistentTree rmt_snapshot(ReadMostlyTree rmt)
+{
+    PersistentTree snapshot = ptree_snapshot(read_version(rmt));
+    ep_exit(rmt->epoch);
+    return snapshot;
+}
+
+// prints items of the tree based on given PrintFunc
+void rmt_print(ReadMostlyTree rmt)
+{
+    ptree_print(atomic_load(&rmt->current));
+}
+
+// destroys the given tree
+void rmt_destroy(ReadMostlyTree rmt)
+{
+    // the retired versions release the items that only they hold; the ones retired to a shared domain are destroyed by it,
+    // which works in any order, since the nodes of the versions are reference counted
+    if (rmt->owns_epoch) ep_destroy(rmt->epoch);
+    ptree_destroy(atomic_load(&rmt->current));
+    pthread_mutex_destroy(&rmt->writer);
+    free(rmt);
+}
+
+// returns the number of elements in the tree
+size_t rmt_size(ReadMostlyTree rmt)
+{
+    size_t size = ptree_size(read_version(rmt));
+    ep_exit(rmt->epoch);
+    return size;
+}
+
+// returns true/false depending on if tree is empty or not
+bool rmt_is_empty(ReadMostlyTree rmt)
+{
+    if (!rmt_size(rmt)) return true;
+    else return false;
+}
+
+// returns the epoch domain of the tree
+EpochDomain rmt_epoch(ReadMostlyTree rmt)
+{
+    return rmt->epoch;
+}
+
+// sets as new DestroyFunc of given tree the given one
+void rmt_set_destroy(ReadMostlyTree rmt, DestroyFunc destroy)
+{
+    ptree_set_destroy(atomic_load(&rmt->current), destroy);
+}
+
+// sets as new PrintFunc of given tree the given one
+void rmt_set_print(ReadMostlyTree rmt, PrintFunc print)
+{
+    ptree_set_print(atomic_load(&rmt->current), print);
+}
@@ -0,0 +1,96 @@
+/* Interface file of (concurrent) Read-Mostly Tree ADT */
+
+#ifndef READ_MOSTLY_TREE_H
+#define READ_MOSTLY_TREE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+/* pointer to function that compares two elements a and b. Returns:
+   < 0 if a < b
+   = 0 if a = b (based on given comparison)
+   > 0 if a > b                                                   */
+typedef int (*CompareFunc)(Pointer a, Pointer b);
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to function printing tree's item
+typedef void (*PrintFunc)(Pointer);
+
+// pointer to read-mostly tree
+typedef struct read_mostly_tree *ReadMostlyTree;
+
+// pointer to a version of a persistent tree (see PersistentTree.h)
+typedef struct persistent_tree *PersistentTree;
+
+// pointer to epoch domain (see Epoch.h)
+typedef struct epoch_domain *EpochDomain;
+
+/*-----Functions Provided-----*/
+/* All functions except rmt_initialize, rmt_print, rmt_destroy and the setters can be called by many threads at the same
+   time on the same tree. Reads take no locks and don't write any shared memory, so they scale with the number of threads;
+   updates are serialized by a mutex and never block reads. Every read sees the tree as it was after some update.
+   A removed item is destroyed once no read can still be using it; an item returned by rmt_find, rmt_min or rmt_max
+   may be destroyed after the call returns, unless the call is made inside ep_enter/ep_exit of rmt_epoch.
+   An epoch domain takes a pthread key, so at most PTHREAD_KEYS_MAX (usually 1024) trees initialized with rmt_initialize
+   can exist at the same time; any number of trees can share one domain, through rmt_initialize_shared.            */
+
+// initializes an empty read-mostly tree, with an epoch domain of its own (destroyed along with the tree)
+// returns false if the domain can't be created, since the program has run out of pthread keys; the tree is then NULL
+bool rmt_initialize(ReadMostlyTree *, CompareFunc, DestroyFunc, PrintFunc);
+
+// initializes an empty read-mostly tree that uses given epoch domain, which can be shared by many containers
+// the domain must outlive the tree; the versions replaced by updates are destroyed by the domain, even after rmt_destroy
+void rmt_initialize_shared(ReadMostlyTree *, EpochDomain, CompareFunc, DestroyFunc, PrintFunc);
+
+// inserts given item in the tree
+// returns false if an equal item is already in the tree (given item is then not inserted)
+bool rmt_insert(Pointer, ReadMostlyTree);
+
+// removes given item from the tree; it's destroyed once no read can still be using it
+// returns false if there is no equal item in the tree
+bool rmt_remove(Pointer, ReadMostlyTree);
+
+// returns true/false based on if given item is found in the tree or not
+bool rmt_search(Pointer, ReadMostlyTree);
+
+// returns the element of the tree that is equal to given item
+// returns NULL if not found
+Pointer rmt_find(Pointer, ReadMostlyTree);
+
+// returns the element with lowest value
+Pointer rmt_min(ReadMostlyTree);
+
+// returns the element with highest value
+Pointer rmt_max(ReadMostlyTree);
+
+// returns the current version of the tree, in O(1); it doesn't change with later updates and must be destroyed
+// with ptree_destroy (its items stay valid until then)
+PersistentTree rmt_snapshot(ReadMostlyTree);
+
+// prints items of the tree
+void rmt_print(ReadMostlyTree);
+
+// destroys the given tree, along with its items
+void rmt_destroy(ReadMostlyTree);
+
+// returns the number of elements in the tree
+size_t rmt_size(ReadMostlyTree);
+
+// returns true/false depending on if tree is empty or not
+bool rmt_is_empty(ReadMostlyTree);
+
+// returns the epoch domain of the tree; its critical sections keep the items read meanwhile from being destroyed
+EpochDomain rmt_epoch(ReadMostlyTree);
+
+// sets as new DestroyFunc of given tree the given one
+void rmt_set_destroy(ReadMostlyTree, DestroyFunc);
+
+// sets as new PrintFunc of given tree the given one
+void rmt_set_print(ReadMostlyTree, PrintFunc);
+
+#endif
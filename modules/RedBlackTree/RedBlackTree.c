@@ -1,7 +1,29 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include <assert.h>
+#include <stdatomic.h>
 #include "RedBlackTree.h"
+#include "../FrozenIndex/FrozenIndex.h"
+#include "../MappedIndex/MappedIndex.h"
+#include "../ThreadPool/ThreadPool.h"
+
+// header of a tree snapshot stream (shared with the BST module, so snapshots of both trees are interchangeable)
+#define SNAPSHOT_MAGIC "ADTS"
+#define SNAPSHOT_VERSION 1
+
+// size of an rbt that was split, until its nodes are counted
+#define SIZE_UNKNOWN ((size_t)-1)
+
+// number of searches interleaved by red_black_search_batch
+#define SEARCH_LANES 16
+
+#ifdef __GNUC__
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)(address))
+#endif
 
 // node color enum
 typedef enum{
@@ -19,7 +41,10 @@ typedef struct rbt_node{
 // red black tree struct
 struct red_black_tree{
     rbt_node *root; // pointer to the root of the rbt
-    int size; // number of elements in the rbt
+    size_t size; // number of elements in the rbt (SIZE_UNKNOWN after a split, until counted)
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
     CompareFunc Compare;
     DestroyFunc Destroy;
     PrintFunc Print;
@@ -44,16 +69,23 @@ static rbt_node *create_node(Pointer item, rbt_node *l, rbt_node *r, rbt_node *p
     return node;
 }
 
+// compares the given items based on the CompareFunc of given rbt
+static int compare_items(RedBlackTree rbt, Pointer a, Pointer b)
+{
+    STATS_INC(rbt, comparisons);
+    return rbt->Compare(a, b);
+}
+
 // finds the rbt node of given item
 // returns NULLnode if not found
-static rbt_node *find_node(rbt_node *root_node, Pointer item, CompareFunc compare)
+static rbt_node *find_node(rbt_node *root_node, Pointer item, RedBlackTree rbt)
 {
     if (root_node == NULLnode) return NULLnode;
-    int comp_result = compare(item, root_node->data);
+    int comp_result = compare_items(rbt, item, root_node->data);
     if (!comp_result) return root_node; // found
     // search in the appropriate root's subtree
-    if (comp_result < 0) return find_node(root_node->left, item, compare);
-    else return find_node(root_node->right, item, compare);
+    if (comp_result < 0) return find_node(root_node->left, item, rbt);
+    else return find_node(root_node->right, item, rbt);
 }
 
 // returns sibling of given node
@@ -71,7 +103,8 @@ static rbt_node *right_rotation(rbt_node *head)
 {
     rbt_node *node = head->left;
     // need to update x->right's parent; after the rotation its parent will become head
-    node->right->parent = head;
+    // (the shared NULLnode is never written, so that different trees can be used by different threads)
+    if (node->right != NULLnode) node->right->parent = head;
     head->left = node->right;
     node->right = head;
     return node;
@@ -82,7 +115,7 @@ static rbt_node *left_rotation(rbt_node *head)
 {
     rbt_node *node = head->right;
     // need to update x->left's parent; after the rotation its parent will become head
-    node->left->parent = head;
+    if (node->left != NULLnode) node->left->parent = head;
     head->right = node->left;
     node->left = head;
     return node;
@@ -106,7 +139,7 @@ static rbt_node *right_left_rotation(rbt_node *head)
 
 // performs a simple trinode-restructuring algorithm
 // used to solve double-red and double-black problems
-static rbt_node *trinode_restructuring(rbt_node *root_node, rbt_node *z, CompareFunc compare, int problem)
+static rbt_node *trinode_restructuring(rbt_node *root_node, rbt_node *z, RedBlackTree rbt, int problem)
 {
     // z = node/child, v = parent of z, u = grandparent of z
     rbt_node *v = z->parent;
@@ -114,28 +147,40 @@ static rbt_node *trinode_restructuring(rbt_node *root_node, rbt_node *z, Compare
 
     // determine a, b, c; a,b,c are u,v,z in ascending order
     rbt_node *a, *b, *c;
-    if (compare(z->data, v->data) < 0 && compare(z->data, u->data) < 0){
+    if (compare_items(rbt, z->data, v->data) < 0 && compare_items(rbt, z->data, u->data) < 0){
         a = z;
-        if (compare(v->data, u->data) < 0) c = u;
+        if (compare_items(rbt, v->data, u->data) < 0) c = u;
         else c = v;
     }
-    else if (compare(v->data, z->data) < 0 && compare(v->data, u->data) < 0){
+    else if (compare_items(rbt, v->data, z->data) < 0 && compare_items(rbt, v->data, u->data) < 0){
         a = v;
-        if (compare(z->data, u->data) < 0) c = u;
+        if (compare_items(rbt, z->data, u->data) < 0) c = u;
         else c = z;
     }
     else{
         a = u;
-        if (compare(z->data, v->data) < 0) c = v;
+        if (compare_items(rbt, z->data, v->data) < 0) c = v;
         else c = z;
     }
 
     // create a new trinode-tree using a,b,c using rotations; restructure
     // determine the type of needed rotation(s), and make b the new "grandparent" node
-    if (u->left == v && v->left == z) b = right_rotation(u);
-    else if (u->right == v && v->right == z) b = left_rotation(u);
-    else if (u->left == v && v->right == z) b = left_right_rotation(u);
-    else b = right_left_rotation(u);
+    if (u->left == v && v->left == z){
+        b = right_rotation(u);
+        STATS_INC(rbt, rotations);
+    }
+    else if (u->right == v && v->right == z){
+        b = left_rotation(u);
+        STATS_INC(rbt, rotations);
+    }
+    else if (u->left == v && v->right == z){
+        b = left_right_rotation(u);
+        STATS_ADD(rbt, rotations, 2);
+    }
+    else{
+        b = right_left_rotation(u);
+        STATS_ADD(rbt, rotations, 2);
+    }
 
     // a will be the left child of b and c the right one
     // connect a and c with b
@@ -188,6 +233,15 @@ static rbt_node *in_order_successor(rbt_node *node)
     return successor;
 }
 
+// returns the node with the next item in-order after the item of given node, or NULLnode if there is none
+static rbt_node *next_node(rbt_node *node)
+{
+    if (node->right != NULLnode) return in_order_successor(node);
+    // else; go up while node is a right child; the parent of the first left child is the successor
+    while (node->parent != NULLnode && node->parent->right == node) node = node->parent;
+    return node->parent;
+}
+
 // removes given node from rbt and returns the new form of the tree
 // basic bst-deletion
 static rbt_node *node_remove(rbt_node *root, rbt_node *node, DestroyFunc destroy)
@@ -232,14 +286,14 @@ static rbt_node *node_remove(rbt_node *root, rbt_node *node, DestroyFunc destroy
 }
 
 // adjustment operation, perfomed in deletion of node if double black sibling is red
-static rbt_node *adjustment(rbt_node *head, rbt_node *y, CompareFunc compare)
+static rbt_node *adjustment(rbt_node *head, rbt_node *y, RedBlackTree rbt)
 {
     // y is double black node's sibling, x is y's parent, z is y's chosen child used for the restructure
     rbt_node *x = y->parent, *z;
     if (x->right == y) z = y->right;
     else z = y->left;
     // perform the appropriate adjustment using trinode-restructuring
-    head = trinode_restructuring(head, z, compare, 1);
+    head = trinode_restructuring(head, z, rbt, 1);
     // color y black and x red
     y->color = BLACK;
     x->color = RED;
@@ -248,7 +302,7 @@ static rbt_node *adjustment(rbt_node *head, rbt_node *y, CompareFunc compare)
 }
 
 // fixes the double-black problem, given the head of the tree and double black node's sibling
-static rbt_node *fix_double_black(rbt_node *head, rbt_node *sibling, CompareFunc compare)
+static rbt_node *fix_double_black(rbt_node *head, rbt_node *sibling, RedBlackTree rbt)
 {
     // base case
     if (sibling == NULLnode) return head;
@@ -265,7 +319,7 @@ static rbt_node *fix_double_black(rbt_node *head, rbt_node *sibling, CompareFunc
         if (sibling->parent->left == sibling) new_sibling = sibling->right;
         else new_sibling = sibling->left;
         // perform the adjustment
-        head = adjustment(head, sibling, compare); 
+        head = adjustment(head, sibling, rbt); 
         // assign to sibling the new_sibling, and apply one of the next cases
         sibling = new_sibling;
     }
@@ -274,10 +328,10 @@ static rbt_node *fix_double_black(rbt_node *head, rbt_node *sibling, CompareFunc
     if (sibling->color == BLACK){
         // perform trinode restructuring to resolve the depth property and fix colors
         if (sibling->left->color == RED){
-            head = trinode_restructuring(head, sibling->left, compare, 1);
+            head = trinode_restructuring(head, sibling->left, rbt, 1);
             return head;
         }else if (sibling->right->color == RED){
-            head = trinode_restructuring(head, sibling->right, compare, 1);
+            head = trinode_restructuring(head, sibling->right, rbt, 1);
             return head;
         }
     }
@@ -286,12 +340,13 @@ static rbt_node *fix_double_black(rbt_node *head, rbt_node *sibling, CompareFunc
     if (sibling->color == BLACK && sibling->left->color == BLACK && sibling->right->color == BLACK){
         // perform recoloring
         sibling->color = RED;
+        STATS_INC(rbt, recolorings);
         // check parent's color
         if (sibling->parent->color == RED){
             sibling->parent->color = BLACK;
         }else{
             // double black appeared at the parent
-            head = fix_double_black(head, find_sibling(sibling->parent), compare);
+            head = fix_double_black(head, find_sibling(sibling->parent), rbt);
         }
     }
     return head;
@@ -329,6 +384,99 @@ static void destroy_nodes(rbt_node *node, DestroyFunc destroy_func)
     free(node);
 }
 
+// writes the items of given rbt nodes to the stream in-order, based on given SerializeFunc
+static bool save_tree_nodes(rbt_node *node, FILE *stream, SerializeFunc serialize)
+{
+    if (node == NULLnode) return true;
+    return save_tree_nodes(node->left, stream, serialize) && serialize(node->data, stream) &&
+           save_tree_nodes(node->right, stream, serialize);
+}
+
+// builds a balanced rbt of n nodes, reading their items in-order from the stream
+// nodes at depth red_depth (the last, incomplete level) are colored red; all others are black
+// if an item can't be read, ok becomes false and the nodes built so far are returned
+static rbt_node *load_tree_nodes(uint64_t n, int depth, int red_depth, FILE *stream, DeserializeFunc deserialize, bool *ok)
+{
+    if (n == 0 || !*ok) return NULLnode;
+    // the middle item is the root; the first half of the items goes to its left subtree
+    uint64_t left_size = (n - 1) / 2;
+    rbt_node *left = load_tree_nodes(left_size, depth + 1, red_depth, stream, deserialize, ok);
+    Pointer item = *ok ? deserialize(stream) : NULL;
+    if (item == NULL){
+        *ok = false;
+        return left;
+    }
+    rbt_node *node = create_node(item, left, NULLnode, NULLnode);
+    node->color = depth == red_depth ? RED : BLACK;
+    if (left != NULLnode) left->parent = node;
+    node->right = load_tree_nodes(n - 1 - left_size, depth + 1, red_depth, stream, deserialize, ok);
+    if (node->right != NULLnode) node->right->parent = node;
+    return node;
+}
+
+// stores the items of given rbt nodes in-order in the items array, starting from index i
+// returns the index after the last stored item
+static size_t collect_items(rbt_node *node, Pointer *items, size_t i)
+{
+    if (node == NULLnode) return i;
+    i = collect_items(node->left, items, i);
+    items[i++] = node->data;
+    return collect_items(node->right, items, i);
+}
+
+// returns the number of nodes in the subtree of given node
+static size_t count_nodes(rbt_node *node)
+{
+    if (node == NULLnode) return 0;
+    return count_nodes(node->left) + 1 + count_nodes(node->right);
+}
+
+// adds n to the size of the rbt (removes -n, if n is negative), if its size is known
+static void update_size(RedBlackTree rbt, long n)
+{
+    if (rbt->size == SIZE_UNKNOWN) return;
+    rbt->size += n;
+    STATS_MAX(rbt, peak_size, rbt->size);
+}
+
+// returns the height (number of levels) of the subtree of given node
+static int tree_height(rbt_node *node)
+{
+    if (node == NULLnode) return 0;
+    int left = tree_height(node->left), right = tree_height(node->right);
+    return 1 + (left > right ? left : right);
+}
+
+// counts the nodes of the subtree of given node per depth, for depths smaller than length
+static void count_depths(rbt_node *node, int depth, size_t *histogram, int length)
+{
+    if (node == NULLnode || depth >= length) return;
+    histogram[depth]++;
+    count_depths(node->left, depth + 1, histogram, length);
+    count_depths(node->right, depth + 1, histogram, length);
+}
+
+// checks the subtree of given node in-order, with prev being the last visited node
+// returns the black height of the subtree (number of black nodes on any path down to a leaf),
+// or -1 if any of the ordering, coloring or parent pointer properties is violated
+static int verify_nodes(rbt_node *node, rbt_node *parent, rbt_node **prev, size_t *count, RedBlackTree rbt)
+{
+    if (node == NULLnode) return 0;
+    if (node->parent != parent) return -1;
+    // a red node can't have a red child
+    if (node->color == RED && (node->left->color == RED || node->right->color == RED)) return -1;
+    int left = verify_nodes(node->left, node, prev, count, rbt);
+    if (left < 0) return -1;
+    // the items must be visited in strictly ascending order
+    if (*prev != NULLnode && compare_items(rbt, (*prev)->data, node->data) >= 0) return -1;
+    *prev = node;
+    (*count)++;
+    int right = verify_nodes(node->right, node, prev, count, rbt);
+    // every path down to a leaf must have the same number of black nodes
+    if (right < 0 || left != right) return -1;
+    return left + (node->color == BLACK ? 1 : 0);
+}
+
 // returns the node that will replace the node to be removed from a red-black tree
 static rbt_node *find_replacement(rbt_node *node_rm)
 {
@@ -341,6 +489,568 @@ static rbt_node *find_replacement(rbt_node *node_rm)
     else return node_rm->right;
 }
 
+// join-based functions
+/* Join(L, k, R) links two rbts and a middle node k, where every item of L is smaller than k's item and every
+   item of R is greater, in O(|bh(L) - bh(R)|): k is placed on the spine of the taller tree, at the black node
+   whose black height equals the one of the shorter tree, and at most one red-red violation is fixed on the way
+   back up. Split and the set operations are built on top of join and reuse the existing nodes. The black height
+   (bh) of a subtree counts the black nodes on any path from its root down to a leaf, including the root. */
+
+// returns the black height of the subtree of given node
+static int black_height(rbt_node *node)
+{
+    int black_height = 0;
+    for (; node != NULLnode; node = node->left){
+        if (node->color == BLACK) black_height++;
+    }
+    return black_height;
+}
+
+// makes left and right the children of given node
+static void set_children(rbt_node *node, rbt_node *left, rbt_node *right)
+{
+    node->left = left;
+    node->right = right;
+    if (left != NULLnode) left->parent = node;
+    if (right != NULLnode) right->parent = node;
+}
+
+// detaches given subtree from its parent, making it the root of a tree on its own
+static rbt_node *detach(rbt_node *node)
+{
+    if (node != NULLnode) node->parent = NULLnode;
+    return node;
+}
+
+// joins tl, k and tr, with bh(tl) >= bh(tr) and tr having a black root, by placing k on the right spine of tl
+static rbt_node *join_right(rbt_node *tl, int bh_l, rbt_node *k, rbt_node *tr, int bh_r)
+{
+    if (bh_l == bh_r && tl->color == BLACK){
+        set_children(k, tl, tr);
+        k->color = RED;
+        return k;
+    }
+    rbt_node *right = join_right(tl->right, bh_l - (tl->color == BLACK ? 1 : 0), k, tr, bh_r);
+    set_children(tl, tl->left, right);
+    // a red child with a red right child under a black node is fixed by a left rotation
+    if (tl->color == BLACK && right->color == RED && right->right->color == RED){
+        right->right->color = BLACK;
+        set_children(tl, tl->left, right->left);
+        set_children(right, tl, right->right);
+        return right;
+    }
+    return tl;
+}
+
+// joins tl, k and tr, with bh(tr) >= bh(tl) and tl having a black root, by placing k on the left spine of tr
+static rbt_node *join_left(rbt_node *tl, int bh_l, rbt_node *k, rbt_node *tr, int bh_r)
+{
+    if (bh_l == bh_r && tr->color == BLACK){
+        set_children(k, tl, tr);
+        k->color = RED;
+        return k;
+    }
+    rbt_node *left = join_left(tl, bh_l, k, tr->left, bh_r - (tr->color == BLACK ? 1 : 0));
+    set_children(tr, left, tr->right);
+    // a red child with a red left child under a black node is fixed by a right rotation
+    if (tr->color == BLACK && left->color == RED && left->left->color == RED){
+        left->left->color = BLACK;
+        set_children(tr, left->right, tr->right);
+        set_children(left, left->left, tr);
+        return left;
+    }
+    return tr;
+}
+
+// joins the trees tl and tr with node k in the middle and returns the root of the new tree
+// the black height of the new tree is stored in bh
+static rbt_node *join_nodes(rbt_node *tl, int bh_l, rbt_node *k, rbt_node *tr, int bh_r, int *bh)
+{
+    // the roots of the joined trees are made black, so that k never ends up below a red root
+    if (tl->color == RED){
+        tl->color = BLACK;
+        bh_l++;
+    }
+    if (tr->color == RED){
+        tr->color = BLACK;
+        bh_r++;
+    }
+    rbt_node *root;
+    if (bh_l > bh_r){
+        root = join_right(tl, bh_l, k, tr, bh_r);
+        *bh = bh_l;
+        // the rotation at the top of the spine may have left a red-red violation at the root
+        if (root->color == RED && root->right->color == RED){
+            root->color = BLACK;
+            (*bh)++;
+        }
+    }
+    else if (bh_r > bh_l){
+        root = join_left(tl, bh_l, k, tr, bh_r);
+        *bh = bh_r;
+        if (root->color == RED && root->left->color == RED){
+            root->color = BLACK;
+            (*bh)++;
+        }
+    }
+    else{
+        set_children(k, tl, tr);
+        k->color = BLACK;
+        root = k;
+        *bh = bh_l + 1;
+    }
+    return detach(root);
+}
+
+// removes the node with the largest item from the tree of given root and returns it
+// the remaining tree and its black height are stored in rest and bh_rest
+static rbt_node *split_last(rbt_node *root, int bh, rbt_node **rest, int *bh_rest)
+{
+    int child_bh = bh - (root->color == BLACK ? 1 : 0);
+    if (root->right == NULLnode){
+        *rest = detach(root->left);
+        *bh_rest = child_bh;
+        return root;
+    }
+    rbt_node *right;
+    int bh_right;
+    rbt_node *last = split_last(root->right, child_bh, &right, &bh_right);
+    *rest = join_nodes(detach(root->left), child_bh, root, right, bh_right, bh_rest);
+    return last;
+}
+
+// joins the trees tl and tr, where every item of tl is smaller than every item of tr
+static rbt_node *join_trees(rbt_node *tl, int bh_l, rbt_node *tr, int bh_r, int *bh)
+{
+    if (tl == NULLnode){
+        *bh = bh_r;
+        return tr;
+    }
+    if (tr == NULLnode){
+        *bh = bh_l;
+        return tl;
+    }
+    rbt_node *rest;
+    int bh_rest;
+    rbt_node *k = split_last(tl, bh_l, &rest, &bh_rest);
+    return join_nodes(rest, bh_rest, k, tr, bh_r, bh);
+}
+
+// splits the tree of given root into the tree of the items smaller than item (stored in left)
+// and the tree of the items greater than item (stored in right), together with their black heights
+// returns the node holding an item equal to given item, detached from both trees, or NULLnode if there is none
+static rbt_node *split_nodes(rbt_node *root, int bh, Pointer item, RedBlackTree rbt, rbt_node **left, int *bh_l, rbt_node **right, int *bh_r)
+{
+    if (root == NULLnode){
+        *left = *right = NULLnode;
+        *bh_l = *bh_r = 0;
+        return NULLnode;
+    }
+    int child_bh = bh - (root->color == BLACK ? 1 : 0);
+    rbt_node *l = detach(root->left), *r = detach(root->right);
+    int comp_result = compare_items(rbt, item, root->data);
+    if (!comp_result){
+        *left = l;
+        *right = r;
+        *bh_l = *bh_r = child_bh;
+        return root;
+    }
+    rbt_node *found, *middle;
+    int bh_middle;
+    if (comp_result < 0){
+        // root and its right subtree are greater than item
+        found = split_nodes(l, child_bh, item, rbt, left, bh_l, &middle, &bh_middle);
+        *right = join_nodes(middle, bh_middle, root, r, child_bh, bh_r);
+    }else{
+        // root and its left subtree are smaller than item
+        found = split_nodes(r, child_bh, item, rbt, &middle, &bh_middle, right, bh_r);
+        *left = join_nodes(l, child_bh, root, middle, bh_middle, bh_l);
+    }
+    return found;
+}
+
+// returns the union of the trees of roots a and b, keeping the items of a when both trees hold equal items
+// the duplicate items of b are destroyed; their number is added to duplicates
+static rbt_node *union_nodes(rbt_node *a, int bh_a, rbt_node *b, int bh_b, RedBlackTree rbt, DestroyFunc destroy_b, size_t *duplicates, int *bh)
+{
+    if (b == NULLnode){
+        *bh = bh_a;
+        return a;
+    }
+    if (a == NULLnode){
+        *bh = bh_b;
+        return b;
+    }
+    // split a by the root item of b, which is reused as the middle node of the join
+    int child_bh = bh_b - (b->color == BLACK ? 1 : 0);
+    rbt_node *b_left = detach(b->left), *b_right = detach(b->right);
+    rbt_node *a_left, *a_right;
+    int bh_a_left, bh_a_right;
+    rbt_node *found = split_nodes(a, bh_a, b->data, rbt, &a_left, &bh_a_left, &a_right, &bh_a_right);
+    if (found != NULLnode){
+        if (destroy_b != NULL) destroy_b(b->data);
+        b->data = found->data;
+        free(found);
+        (*duplicates)++;
+    }
+    int bh_left, bh_right;
+    rbt_node *left = union_nodes(a_left, bh_a_left, b_left, child_bh, rbt, destroy_b, duplicates, &bh_left);
+    rbt_node *right = union_nodes(a_right, bh_a_right, b_right, child_bh, rbt, destroy_b, duplicates, &bh_right);
+    return join_nodes(left, bh_left, b, right, bh_right, bh);
+}
+
+// returns the tree of the items of a that are also in b; all other nodes are destroyed
+// the number of kept items is added to kept
+static rbt_node *intersect_nodes(rbt_node *a, int bh_a, rbt_node *b, int bh_b, RedBlackTree rbt, DestroyFunc destroy_b, size_t *kept, int *bh)
+{
+    if (a == NULLnode || b == NULLnode){
+        destroy_nodes(a, rbt->Destroy);
+        destroy_nodes(b, destroy_b);
+        *bh = 0;
+        return NULLnode;
+    }
+    int child_bh = bh_b - (b->color == BLACK ? 1 : 0);
+    rbt_node *b_left = detach(b->left), *b_right = detach(b->right);
+    rbt_node *a_left, *a_right;
+    int bh_a_left, bh_a_right;
+    rbt_node *found = split_nodes(a, bh_a, b->data, rbt, &a_left, &bh_a_left, &a_right, &bh_a_right);
+    if (destroy_b != NULL) destroy_b(b->data);
+    free(b);
+    int bh_left, bh_right;
+    rbt_node *left = intersect_nodes(a_left, bh_a_left, b_left, child_bh, rbt, destroy_b, kept, &bh_left);
+    rbt_node *right = intersect_nodes(a_right, bh_a_right, b_right, child_bh, rbt, destroy_b, kept, &bh_right);
+    if (found == NULLnode) return join_trees(left, bh_left, right, bh_right, bh);
+    (*kept)++;
+    return join_nodes(left, bh_left, found, right, bh_right, bh);
+}
+
+// returns the tree of the items of a that are not in b; all other nodes are destroyed
+// the number of removed items of a is added to removed
+static rbt_node *difference_nodes(rbt_node *a, int bh_a, rbt_node *b, int bh_b, RedBlackTree rbt, DestroyFunc destroy_b, size_t *removed, int *bh)
+{
+    if (a == NULLnode || b == NULLnode){
+        destroy_nodes(b, destroy_b);
+        *bh = bh_a;
+        return a;
+    }
+    int child_bh = bh_b - (b->color == BLACK ? 1 : 0);
+    rbt_node *b_left = detach(b->left), *b_right = detach(b->right);
+    rbt_node *a_left, *a_right;
+    int bh_a_left, bh_a_right;
+    rbt_node *found = split_nodes(a, bh_a, b->data, rbt, &a_left, &bh_a_left, &a_right, &bh_a_right);
+    if (found != NULLnode){
+        if (rbt->Destroy != NULL) rbt->Destroy(found->data);
+        free(found);
+        (*removed)++;
+    }
+    if (destroy_b != NULL) destroy_b(b->data);
+    free(b);
+    int bh_left, bh_right;
+    rbt_node *left = difference_nodes(a_left, bh_a_left, b_left, child_bh, rbt, destroy_b, removed, &bh_left);
+    rbt_node *right = difference_nodes(a_right, bh_a_right, b_right, child_bh, rbt, destroy_b, removed, &bh_right);
+    return join_trees(left, bh_left, right, bh_right, bh);
+}
+
+// makes given node the root of the rbt; the root of a tree is always black
+static void set_root(RedBlackTree rbt, rbt_node *root)
+{
+    rbt->root = detach(root);
+    if (root != NULLnode) root->color = BLACK;
+}
+
+// parallel functions
+/* The parallel operations fork over subtrees: one half is handed to a task of the thread pool while the calling
+   thread processes the other half, and then waits for the task (running other pending tasks in the meantime).
+   Subtrees of black height below PARALLEL_BLACK_HEIGHT (less than 2^PARALLEL_BLACK_HEIGHT nodes may remain) and
+   arrays of less than PARALLEL_MIN_ITEMS items are processed sequentially, so a task is never too small to be
+   worth its spawn. Each task compares items through its own copy of the rbt struct, whose counters are added
+   to the ones of the rbt when the task is done. Without a thread pool (NULL), everything runs sequentially. */
+#define PARALLEL_BLACK_HEIGHT 10
+#define PARALLEL_MIN_ITEMS 4096
+
+// task of the parallel merge sort
+typedef struct sort_task{
+    struct red_black_tree tree; // copy of the rbt, used to compare the items
+    Pointer *items, *buffer; // items to sort and buffer of the same size
+    size_t n; // number of items
+    ThreadPool tp;
+}sort_task;
+
+// task of the parallel merge
+typedef struct merge_task{
+    struct red_black_tree tree; // copy of the rbt, used to compare the items
+    Pointer *a, *b; // sorted runs to merge
+    size_t na, nb; // their numbers of items
+    Pointer *out; // array of na + nb items, where the merged run is stored
+    ThreadPool tp;
+}merge_task;
+
+// task of the parallel tree build
+typedef struct build_task{
+    Pointer *items; // sorted items of the subtree
+    size_t n; // number of items
+    int depth, red_depth; // depth of the subtree and depth of its red nodes
+    ThreadPool tp;
+    rbt_node *result; // root of the built subtree
+}build_task;
+
+// task of the parallel union
+typedef struct union_task{
+    struct red_black_tree tree; // copy of the rbt, used to compare the items
+    rbt_node *a, *b; // roots of the trees to merge
+    int bh_a, bh_b; // their black heights
+    DestroyFunc destroy_b;
+    ThreadPool tp;
+    size_t duplicates; // number of duplicate items found by the task
+    rbt_node *result; // root of the union
+    int bh; // black height of the union
+}union_task;
+
+// task of the parallel visit
+typedef struct visit_task{
+    rbt_node *node; // root of the subtree to visit
+    int bh; // its black height
+    VisitFunc visit;
+    void *context;
+    atomic_bool *stop; // set when a VisitFunc returns false
+    ThreadPool tp;
+}visit_task;
+
+// task of the parallel destruction
+typedef struct destroy_task{
+    rbt_node *node; // root of the subtree to destroy
+    int bh; // its black height
+    DestroyFunc destroy;
+    ThreadPool tp;
+}destroy_task;
+
+// makes copy a copy of the rbt with zeroed counters, to be used by a task
+static void copy_tree(RedBlackTree copy, RedBlackTree rbt)
+{
+    *copy = *rbt;
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    copy->stats = stats;
+#endif
+}
+
+// adds the counters of a task's copy of the rbt to the counters of the rbt
+static void add_stats(RedBlackTree rbt, RedBlackTree copy)
+{
+    STATS_ADD(rbt, inserts, copy->stats.inserts);
+    STATS_ADD(rbt, removes, copy->stats.removes);
+    STATS_ADD(rbt, comparisons, copy->stats.comparisons);
+    STATS_ADD(rbt, rotations, copy->stats.rotations);
+    STATS_ADD(rbt, recolorings, copy->stats.recolorings);
+    STATS_ADD(rbt, allocations, copy->stats.allocations);
+    STATS_ADD(rbt, frees, copy->stats.frees);
+}
+
+// returns the number of the n sorted items that are smaller than given item (or not greater, if inclusive)
+static size_t rank_item(Pointer item, Pointer *items, size_t n, bool inclusive, RedBlackTree rbt)
+{
+    size_t low = 0, high = n;
+    while (low < high){
+        size_t mid = low + (high - low) / 2;
+        int comp_result = compare_items(rbt, items[mid], item);
+        if (comp_result < 0 || (inclusive && comp_result == 0)) low = mid + 1;
+        else high = mid;
+    }
+    return low;
+}
+
+static void merge_items(Pointer *a, size_t na, Pointer *b, size_t nb, Pointer *out, RedBlackTree rbt, ThreadPool tp);
+
+static void run_merge_task(Pointer arg)
+{
+    merge_task *task = arg;
+    merge_items(task->a, task->na, task->b, task->nb, task->out, &task->tree, task->tp);
+}
+
+// merges the sorted runs a and b into out; equal items keep their order, the ones of a before the ones of b
+/* In parallel, the middle item of the longer run is located in the other run with a binary search, which splits
+   both runs in a part smaller and a part greater than it; the smaller parts are merged by a new task while the
+   calling thread merges the greater parts, right after them in out. So even the top-level merge of a sort
+   is split over the threads, instead of running on one thread after all the halves are sorted.             */
+static void merge_items(Pointer *a, size_t na, Pointer *b, size_t nb, Pointer *out, RedBlackTree rbt, ThreadPool tp)
+{
+    if (tp == NULL || na + nb < PARALLEL_MIN_ITEMS){
+        size_t i = 0, j = 0, k = 0;
+        while (i < na && j < nb) out[k++] = compare_items(rbt, b[j], a[i]) < 0 ? b[j++] : a[i++];
+        memcpy(out + k, a + i, (na - i) * sizeof(Pointer));
+        memcpy(out + k + na - i, b + j, (nb - j) * sizeof(Pointer));
+        return;
+    }
+    // the items of a equal to the splitting item stay before it, and the ones of b after it
+    size_t i, j;
+    if (na >= nb){
+        i = na / 2;
+        j = rank_item(a[i], b, nb, false, rbt);
+    }else{
+        j = nb / 2;
+        i = rank_item(b[j], a, na, true, rbt);
+    }
+    merge_task task = {.a = a, .na = i, .b = b, .nb = j, .out = out, .tp = tp};
+    copy_tree(&task.tree, rbt);
+    Task handle = tp_spawn(run_merge_task, &task, tp);
+    merge_items(a + i, na - i, b + j, nb - j, out + i + j, rbt, tp);
+    tp_wait(handle, tp);
+    add_stats(rbt, &task.tree);
+}
+
+static void sort_items(Pointer *items, Pointer *buffer, size_t n, RedBlackTree rbt, ThreadPool tp);
+
+static void run_sort_task(Pointer arg)
+{
+    sort_task *task = arg;
+    sort_items(task->items, task->buffer, task->n, &task->tree, task->tp);
+}
+
+// sorts the n items with a stable merge sort, based on the CompareFunc of the rbt
+static void sort_items(Pointer *items, Pointer *buffer, size_t n, RedBlackTree rbt, ThreadPool tp)
+{
+    if (n < 2) return;
+    size_t half = n / 2;
+    if (tp != NULL && n >= PARALLEL_MIN_ITEMS){
+        // the first half is sorted by a new task
+        sort_task task = {.items = items, .buffer = buffer, .n = half, .tp = tp};
+        copy_tree(&task.tree, rbt);
+        Task handle = tp_spawn(run_sort_task, &task, tp);
+        sort_items(items + half, buffer + half, n - half, rbt, tp);
+        tp_wait(handle, tp);
+        add_stats(rbt, &task.tree);
+    }else{
+        sort_items(items, buffer, half, rbt, NULL);
+        sort_items(items + half, buffer + half, n - half, rbt, NULL);
+    }
+    // merge the halves in the buffer (in parallel, if they were sorted in parallel) and move them back
+    merge_items(items, half, items + half, n - half, buffer, rbt, tp);
+    memcpy(items, buffer, n * sizeof(Pointer));
+}
+
+static rbt_node *build_nodes(Pointer *items, size_t n, int depth, int red_depth, ThreadPool tp);
+
+static void run_build_task(Pointer arg)
+{
+    build_task *task = arg;
+    task->result = build_nodes(task->items, task->n, task->depth, task->red_depth, task->tp);
+}
+
+// builds a balanced rbt of the n sorted items, like load_tree_nodes
+static rbt_node *build_nodes(Pointer *items, size_t n, int depth, int red_depth, ThreadPool tp)
+{
+    if (n == 0) return NULLnode;
+    size_t left_size = (n - 1) / 2;
+    rbt_node *node = create_node(items[left_size], NULLnode, NULLnode, NULLnode);
+    node->color = depth == red_depth ? RED : BLACK;
+    rbt_node *left, *right;
+    if (tp != NULL && n >= PARALLEL_MIN_ITEMS){
+        // the left subtree is built by a new task
+        build_task task = {items, left_size, depth + 1, red_depth, tp, NULLnode};
+        Task handle = tp_spawn(run_build_task, &task, tp);
+        right = build_nodes(items + left_size + 1, n - 1 - left_size, depth + 1, red_depth, tp);
+        tp_wait(handle, tp);
+        left = task.result;
+    }else{
+        left = build_nodes(items, left_size, depth + 1, red_depth, NULL);
+        right = build_nodes(items + left_size + 1, n - 1 - left_size, depth + 1, red_depth, NULL);
+    }
+    set_children(node, left, right);
+    return node;
+}
+
+static rbt_node *union_nodes_parallel(rbt_node *a, int bh_a, rbt_node *b, int bh_b, RedBlackTree rbt, DestroyFunc destroy_b, size_t *duplicates, int *bh, ThreadPool tp);
+
+static void run_union_task(Pointer arg)
+{
+    union_task *task = arg;
+    task->result = union_nodes_parallel(task->a, task->bh_a, task->b, task->bh_b, &task->tree, task->destroy_b, &task->duplicates, &task->bh, task->tp);
+}
+
+// union_nodes, with the unions of the left and right parts computed in parallel
+static rbt_node *union_nodes_parallel(rbt_node *a, int bh_a, rbt_node *b, int bh_b, RedBlackTree rbt, DestroyFunc destroy_b, size_t *duplicates, int *bh, ThreadPool tp)
+{
+    if (tp == NULL || a == NULLnode || bh_b < PARALLEL_BLACK_HEIGHT) return union_nodes(a, bh_a, b, bh_b, rbt, destroy_b, duplicates, bh);
+    int child_bh = bh_b - (b->color == BLACK ? 1 : 0);
+    rbt_node *b_left = detach(b->left), *b_right = detach(b->right);
+    rbt_node *a_left, *a_right;
+    int bh_a_left, bh_a_right;
+    rbt_node *found = split_nodes(a, bh_a, b->data, rbt, &a_left, &bh_a_left, &a_right, &bh_a_right);
+    if (found != NULLnode){
+        if (destroy_b != NULL) destroy_b(b->data);
+        b->data = found->data;
+        free(found);
+        (*duplicates)++;
+    }
+    // the left parts are merged by a new task
+    union_task task = {.a = a_left, .b = b_left, .bh_a = bh_a_left, .bh_b = child_bh, .destroy_b = destroy_b, .tp = tp, .duplicates = 0};
+    copy_tree(&task.tree, rbt);
+    Task handle = tp_spawn(run_union_task, &task, tp);
+    int bh_right;
+    rbt_node *right = union_nodes_parallel(a_right, bh_a_right, b_right, child_bh, rbt, destroy_b, duplicates, &bh_right, tp);
+    tp_wait(handle, tp);
+    add_stats(rbt, &task.tree);
+    *duplicates += task.duplicates;
+    return join_nodes(task.result, task.bh, b, right, bh_right, bh);
+}
+
+// visits given rbt nodes in-order until a VisitFunc returns false or the stop flag is set
+static void visit_nodes(rbt_node *node, VisitFunc visit, void *context, atomic_bool *stop)
+{
+    if (node == NULLnode || atomic_load_explicit(stop, memory_order_relaxed)) return;
+    visit_nodes(node->left, visit, context, stop);
+    if (atomic_load_explicit(stop, memory_order_relaxed)) return;
+    if (!visit(node->data, context)) atomic_store_explicit(stop, true, memory_order_relaxed);
+    visit_nodes(node->right, visit, context, stop);
+}
+
+static void visit_nodes_parallel(rbt_node *node, int bh, VisitFunc visit, void *context, atomic_bool *stop, ThreadPool tp);
+
+static void run_visit_task(Pointer arg)
+{
+    visit_task *task = arg;
+    visit_nodes_parallel(task->node, task->bh, task->visit, task->context, task->stop, task->tp);
+}
+
+// visits given rbt nodes, with the left and right subtrees visited in parallel
+static void visit_nodes_parallel(rbt_node *node, int bh, VisitFunc visit, void *context, atomic_bool *stop, ThreadPool tp)
+{
+    if (bh < PARALLEL_BLACK_HEIGHT){
+        visit_nodes(node, visit, context, stop);
+        return;
+    }
+    int child_bh = bh - (node->color == BLACK ? 1 : 0);
+    visit_task task = {node->left, child_bh, visit, context, stop, tp};
+    Task handle = tp_spawn(run_visit_task, &task, tp);
+    if (!atomic_load_explicit(stop, memory_order_relaxed) && !visit(node->data, context)) atomic_store_explicit(stop, true, memory_order_relaxed);
+    visit_nodes_parallel(node->right, child_bh, visit, context, stop, tp);
+    tp_wait(handle, tp);
+}
+
+static void destroy_nodes_parallel(rbt_node *node, int bh, DestroyFunc destroy_func, ThreadPool tp);
+
+static void run_destroy_task(Pointer arg)
+{
+    destroy_task *task = arg;
+    destroy_nodes_parallel(task->node, task->bh, task->destroy, task->tp);
+}
+
+// destroys given rbt nodes, with the left and right subtrees destroyed in parallel
+static void destroy_nodes_parallel(rbt_node *node, int bh, DestroyFunc destroy_func, ThreadPool tp)
+{
+    if (bh < PARALLEL_BLACK_HEIGHT){
+        destroy_nodes(node, destroy_func);
+        return;
+    }
+    int child_bh = bh - (node->color == BLACK ? 1 : 0);
+    destroy_task task = {node->left, child_bh, destroy_func, tp};
+    Task handle = tp_spawn(run_destroy_task, &task, tp);
+    destroy_nodes_parallel(node->right, child_bh, destroy_func, tp);
+    tp_wait(handle, tp);
+    if (destroy_func != NULL) destroy_func(node->data);
+    free(node);
+}
+
 // Red Black Tree ADT functions
 
 // initializes an empty red black tree
@@ -350,6 +1060,7 @@ void red_black_initialize(RedBlackTree *rbt, CompareFunc compare, DestroyFunc de
     assert(*rbt);
     (*rbt)->root = NULLnode;
     (*rbt)->size = 0;
+    red_black_reset_stats(*rbt);
     red_black_set_compare(*rbt, compare);
     red_black_set_destroy(*rbt, destroy);
     red_black_set_print(*rbt, print);
@@ -360,34 +1071,41 @@ void red_black_insert(Pointer item, RedBlackTree rbt)
 {
     // create item's node
     rbt_node *node = create_node(item, NULLnode, NULLnode, NULLnode); // Note: parent pointer will be found after inserting node in the tree
+    STATS_INC(rbt, allocations);
     // check if tree is empty
     if (red_black_is_empty(rbt)){
         // insert the root
         rbt->root = node;
         rbt->root->color = BLACK;
-        rbt->size++;
+        update_size(rbt, 1);
+        STATS_INC(rbt, inserts);
         return;
     }
     // pointer parent has the parent of the new node
     rbt_node *parent = NULLnode;
     rbt_node *current = rbt->root;
+    int comp_result = 0, depth = 0;
     // traverse the tree and find the right place to insert the new node
     while (current != NULLnode){
         parent = current;
-        int comp_result = rbt->Compare(node->data, current->data);
+        comp_result = compare_items(rbt, node->data, current->data);
         if (!comp_result){
             // item already exists, no duplicates are allowed
             free(node);
+            STATS_INC(rbt, frees);
             return;
         }
         else if (comp_result < 0) current = current->left; // go in left subtree
         else current = current->right; // go in right subtree
+        depth++;
     }
-    rbt->size++;
+    update_size(rbt, 1);
+    STATS_INC(rbt, inserts);
+    STATS_MAX(rbt, max_depth, depth);
     // connect node with parent
     node->parent = parent;
-    // find which child of parent is the node; connect to the rbt
-    if (rbt->Compare(node->data, parent->data) < 0) parent->left = node;
+    // find which child of parent is the node (based on the last comparison); connect to the rbt
+    if (comp_result < 0) parent->left = node;
     else parent->right = node;
 
     // check for double red issue; loop until completely fixed
@@ -395,12 +1113,13 @@ void red_black_insert(Pointer item, RedBlackTree rbt)
         // case 1: sibling of parent node is black
         if (find_sibling(node->parent)->color == BLACK){
             // perform trinode restructuring and return
-            rbt->root = trinode_restructuring(rbt->root, node, rbt->Compare, 0);
+            rbt->root = trinode_restructuring(rbt->root, node, rbt, 0);
             break;
         }
         // case 2: sibling of parent node is red
         // perform recoloring
         rbt->root = recoloring(rbt->root, node->parent);
+        STATS_INC(rbt, recolorings);
         // examine whether new double red issue appeared
         node = node->parent->parent; // new node is the grandparent of the old one
     }
@@ -414,8 +1133,8 @@ void red_black_remove(Pointer item, RedBlackTree rbt)
     // check if tree is empty
     if (red_black_is_empty(rbt)) return;
     // check if item doesn't exist in the rbt
-    rbt_node *node = find_node(rbt->root, item, rbt->Compare);
-    if (node == NULL) return;
+    rbt_node *node = find_node(rbt->root, item, rbt);
+    if (node == NULLnode) return;
 
     rbt_node *head = rbt->root;
     // find node's replacement node
@@ -431,7 +1150,7 @@ void red_black_remove(Pointer item, RedBlackTree rbt)
         }else{ 
             head = node_remove(head, node, rbt->Destroy);
             // double black problem
-            head = fix_double_black(head, sibling, rbt->Compare); 
+            head = fix_double_black(head, sibling, rbt); 
         }
     }else{
     // case 2: replacement node is the in-order successor of the node
@@ -440,14 +1159,163 @@ void red_black_remove(Pointer item, RedBlackTree rbt)
         // check for double-black problem in the successor node
         if (rep->color == BLACK && find_replacement(rep)->color == BLACK){
             head = node_remove(head, node, rbt->Destroy);
-            head = fix_double_black(head, sibling, rbt->Compare);
+            head = fix_double_black(head, sibling, rbt);
         }else{
             head = node_remove(head, node, rbt->Destroy);
         }
     }
-    rbt->size--;
-    // assure root's color is black
-    head->color = BLACK;
+    update_size(rbt, -1);
+    STATS_INC(rbt, removes);
+    STATS_INC(rbt, frees);
+    // the root may have changed by the removal or the restructurings; assure its color is black
+    set_root(rbt, head);
+}
+
+// appends the items of rbt b to rbt a; every item of b must be greater than every item of a
+// b is destroyed (but not its items, which are moved to a), in O(log n) without allocating any nodes
+// returns false if the items of the trees overlap; the trees are then left unchanged
+bool red_black_join(RedBlackTree a, RedBlackTree b)
+{
+    if (!red_black_is_empty(a) && !red_black_is_empty(b) && compare_items(a, red_black_max(a), red_black_min(b)) >= 0) return false;
+    int bh;
+    set_root(a, join_trees(a->root, black_height(a->root), b->root, black_height(b->root), &bh));
+    a->size = a->size == SIZE_UNKNOWN || b->size == SIZE_UNKNOWN ? SIZE_UNKNOWN : a->size + b->size;
+    if (a->size != SIZE_UNKNOWN) STATS_MAX(a, peak_size, a->size);
+    free(b);
+    return true;
+}
+
+// splits the rbt in O(log n): the items smaller than given item stay in the rbt and the greater ones are moved
+// to a new rbt, stored in greater, that has the same Compare, Destroy and Print functions
+// returns the item equal to given item, which is removed from the rbt but not destroyed, or NULL if there is none
+Pointer red_black_split(Pointer item, RedBlackTree rbt, RedBlackTree *greater)
+{
+    red_black_initialize(greater, rbt->Compare, rbt->Destroy, rbt->Print);
+    rbt_node *left, *right;
+    int bh_left, bh_right;
+    rbt_node *found = split_nodes(rbt->root, black_height(rbt->root), item, rbt, &left, &bh_left, &right, &bh_right);
+    size_t size = rbt->size;
+    if (size != SIZE_UNKNOWN && found != NULLnode) size--;
+    set_root(rbt, left);
+    set_root(*greater, right);
+    // counting the parts would take O(n); if both are non-empty, their sizes are counted when they are needed
+    if (right == NULLnode) rbt->size = size;
+    else if (left == NULLnode){
+        (*greater)->size = size;
+        rbt->size = 0;
+    }
+    else rbt->size = (*greater)->size = SIZE_UNKNOWN;
+    if (found == NULLnode) return NULL;
+    Pointer found_item = found->data;
+    free(found);
+    STATS_INC(rbt, removes);
+    STATS_INC(rbt, frees);
+    return found_item;
+}
+
+// adds the items of rbt b to rbt a, in O(m log(n/m + 1)) for trees of m <= n items, reusing the nodes of b
+// b is destroyed, along with its items that are equal to items of a (using the DestroyFunc of b)
+void red_black_union(RedBlackTree a, RedBlackTree b)
+{
+    size_t duplicates = 0;
+    int bh;
+    set_root(a, union_nodes(a->root, black_height(a->root), b->root, black_height(b->root), a, b->Destroy, &duplicates, &bh));
+    a->size = a->size == SIZE_UNKNOWN || b->size == SIZE_UNKNOWN ? SIZE_UNKNOWN : a->size + b->size - duplicates;
+    if (a->size != SIZE_UNKNOWN) STATS_MAX(a, peak_size, a->size);
+    free(b);
+}
+
+// keeps in rbt a only the items that are also in rbt b, in O(m log(n/m + 1)) for trees of m <= n items
+// the items of a that are removed, and b along with all of its items, are destroyed
+void red_black_intersect(RedBlackTree a, RedBlackTree b)
+{
+    size_t kept = 0;
+    int bh;
+    set_root(a, intersect_nodes(a->root, black_height(a->root), b->root, black_height(b->root), a, b->Destroy, &kept, &bh));
+    a->size = kept;
+    free(b);
+}
+
+// removes from rbt a the items that are also in rbt b, in O(m log(n/m + 1)) for trees of m <= n items
+// the items of a that are removed, and b along with all of its items, are destroyed
+void red_black_difference(RedBlackTree a, RedBlackTree b)
+{
+    size_t removed = 0;
+    int bh;
+    set_root(a, difference_nodes(a->root, black_height(a->root), b->root, black_height(b->root), a, b->Destroy, &removed, &bh));
+    if (a->size != SIZE_UNKNOWN) a->size -= removed;
+    free(b);
+}
+
+// inserts the n given items in the rbt, like n calls of red_black_insert: items equal to an item of the rbt,
+// or to an earlier item of the array, are not inserted (nor destroyed)
+// the items are sorted and built into a balanced tree, which is merged into the rbt, with the work forked
+// over the threads of given thread pool (sequentially, if it's NULL)
+void red_black_insert_many_parallel(Pointer *items, size_t n, RedBlackTree rbt, ThreadPool tp)
+{
+    if (n == 0) return;
+    Pointer *sorted = malloc(n * sizeof(Pointer)), *buffer = malloc(n * sizeof(Pointer));
+    assert(sorted && buffer);
+    memcpy(sorted, items, n * sizeof(Pointer));
+    sort_items(sorted, buffer, n, rbt, tp);
+    free(buffer);
+    // keep only the first of equal items; the sort is stable, so it's the one that comes first in the array
+    size_t unique = 1;
+    for (size_t i = 1; i < n; i++){
+        if (compare_items(rbt, sorted[unique - 1], sorted[i])) sorted[unique++] = sorted[i];
+    }
+    int red_depth = 0;
+    while (((size_t)2 << red_depth) - 1 <= unique) red_depth++;
+    rbt_node *root = build_nodes(sorted, unique, 0, red_depth, tp);
+    free(sorted);
+    // the nodes of the items that are already in the rbt are freed by the union
+    size_t duplicates = 0;
+    int bh;
+    set_root(rbt, union_nodes_parallel(rbt->root, black_height(rbt->root), root, black_height(root), rbt, NULL, &duplicates, &bh, tp));
+    update_size(rbt, unique - duplicates);
+    STATS_ADD(rbt, allocations, unique);
+    STATS_ADD(rbt, frees, duplicates);
+    STATS_ADD(rbt, inserts, unique - duplicates);
+}
+
+// red_black_union, with the work forked over the threads of given thread pool (sequentially, if it's NULL)
+// the DestroyFunc of b may be called by several threads at the same time
+void red_black_union_parallel(RedBlackTree a, RedBlackTree b, ThreadPool tp)
+{
+    size_t duplicates = 0;
+    int bh;
+    set_root(a, union_nodes_parallel(a->root, black_height(a->root), b->root, black_height(b->root), a, b->Destroy, &duplicates, &bh, tp));
+    a->size = a->size == SIZE_UNKNOWN || b->size == SIZE_UNKNOWN ? SIZE_UNKNOWN : a->size + b->size - duplicates;
+    if (a->size != SIZE_UNKNOWN) STATS_MAX(a, peak_size, a->size);
+    free(b);
+}
+
+// visits the items of the rbt in-order with given VisitFunc, until a visit returns false
+void red_black_for_each(RedBlackTree rbt, VisitFunc visit, void *context)
+{
+    atomic_bool stop = false;
+    visit_nodes(rbt->root, visit, context, &stop);
+}
+
+// initializes given iterator at the smallest item of the rbt
+void red_black_iterator_init(RBTIterator *it, RedBlackTree rbt)
+{
+    rbt_node *node = rbt->root;
+    if (node != NULLnode){
+        while (node->left != NULLnode) node = node->left;
+    }
+    it->node = node != NULLnode ? node : NULL;
+}
+
+// returns the next item of the iterator, or NULL after the last one
+// O(1) amortized, following the parent pointers
+Pointer red_black_iterator_next(RBTIterator *it)
+{
+    if (it->node == NULL) return NULL;
+    Pointer item = it->node->data;
+    rbt_node *next = next_node(it->node);
+    it->node = next != NULLnode ? next : NULL;
+    return item;
 }
 
 // prints items of the rbt 
@@ -466,23 +1334,174 @@ void red_black_destroy(RedBlackTree rbt)
     free(rbt);
 }
 
+// visits the items of the rbt with given VisitFunc, forking over the threads of given thread pool
+// the items are visited in no particular order, and the VisitFunc may be called by several threads at the same time
+// once a VisitFunc returns false no more visits are started, but visits in progress on other threads still complete
+void red_black_for_each_parallel(RedBlackTree rbt, VisitFunc visit, void *context, ThreadPool tp)
+{
+    atomic_bool stop = false;
+    if (tp == NULL) visit_nodes(rbt->root, visit, context, &stop);
+    else visit_nodes_parallel(rbt->root, black_height(rbt->root), visit, context, &stop, tp);
+}
+
+// red_black_destroy, with the nodes freed by the threads of given thread pool (sequentially, if it's NULL)
+// the DestroyFunc of the rbt may be called by several threads at the same time
+void red_black_destroy_parallel(RedBlackTree rbt, ThreadPool tp)
+{
+    if (tp == NULL) destroy_nodes(rbt->root, rbt->Destroy);
+    else destroy_nodes_parallel(rbt->root, black_height(rbt->root), rbt->Destroy, tp);
+    free(rbt);
+}
+
+// writes a snapshot of the rbt to given stream: a header followed by the items in-order
+// returns true on success
+bool red_black_save(RedBlackTree rbt, FILE *stream, SerializeFunc serialize)
+{
+    uint32_t version = SNAPSHOT_VERSION;
+    uint64_t count = red_black_size(rbt);
+    if (fwrite(SNAPSHOT_MAGIC, 1, 4, stream) != 4 || fwrite(&version, sizeof(version), 1, stream) != 1 ||
+        fwrite(&count, sizeof(count), 1, stream) != 1) return false;
+    return save_tree_nodes(rbt->root, stream, serialize);
+}
+
+// initializes a red black tree from a snapshot written by red_black_save (or bst_save)
+// the tree is built in O(n) without comparing items, since the items are already sorted
+// returns false if the snapshot can't be read; the tree is then left empty
+bool red_black_load(RedBlackTree *rbt, FILE *stream, DeserializeFunc deserialize, CompareFunc compare, DestroyFunc destroy, PrintFunc print)
+{
+    red_black_initialize(rbt, compare, destroy, print);
+    // read and check the header
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    if (fread(magic, 1, 4, stream) != 4 || memcmp(magic, SNAPSHOT_MAGIC, 4) ||
+        fread(&version, sizeof(version), 1, stream) != 1 || version != SNAPSHOT_VERSION ||
+        fread(&count, sizeof(count), 1, stream) != 1) return false;
+    // all levels but the last one will be complete; the nodes of the last level are colored red
+    int red_depth = 0;
+    while ((UINT64_C(2) << red_depth) - 1 <= count) red_depth++;
+    bool ok = true;
+    rbt_node *root = load_tree_nodes(count, 0, red_depth, stream, deserialize, &ok);
+    if (!ok){
+        destroy_nodes(root, destroy);
+        return false;
+    }
+    (*rbt)->root = root;
+    (*rbt)->size = count;
+    red_black_reset_stats(*rbt);
+    STATS_ADD(*rbt, allocations, count);
+    return true;
+}
+
+// turns the rbt into a read-only frozen index holding its items
+// the rbt is destroyed (but not its items, which are moved to the frozen index)
+FrozenIndex red_black_freeze(RedBlackTree rbt)
+{
+    size_t size = red_black_size(rbt);
+    Pointer *items = malloc((size + 1) * sizeof(Pointer));
+    assert(items);
+    collect_items(rbt->root, items, 0);
+    FrozenIndex fi;
+    fi_initialize_from_sorted(&fi, items, size, rbt->Compare, rbt->Destroy, rbt->Print);
+    free(items);
+    destroy_nodes(rbt->root, NULL);
+    free(rbt);
+    return fi;
+}
+
+// writes the items of the rbt to an index file that can be opened with mi_open
+// every item is encoded into a key of key_size bytes and a value of value_size bytes
+// returns true on success
+bool red_black_export(RedBlackTree rbt, const char *path, EncodeFunc encode, int key_size, int value_size)
+{
+    size_t size = red_black_size(rbt);
+    Pointer *items = malloc((size + 1) * sizeof(Pointer));
+    assert(items);
+    collect_items(rbt->root, items, 0);
+    bool ok = mi_write_sorted(path, items, size, encode, key_size, value_size);
+    free(items);
+    return ok;
+}
+
 // returns the number of elements in the rbt
-int red_black_size(RedBlackTree rbt)
+// O(1), except for the first call after a split, which counts the nodes of the rbt in O(n) and stores the count
+size_t red_black_size(RedBlackTree rbt)
 {
+    if (rbt->size == SIZE_UNKNOWN) rbt->size = count_nodes(rbt->root);
     return rbt->size;
 }
 
 // returns true/false depending on if rbt is empty or not
 bool red_black_is_empty(RedBlackTree rbt)
 {
-    if (!red_black_size(rbt)) return true;
+    if (rbt->root == NULLnode) return true;
     else return false;
 }
 
 // returns true/false based on if given item is found in the rbt or not
 bool red_black_search(Pointer item, RedBlackTree rbt)
 {
-    return find_node(rbt->root, item, rbt->Compare) != NULLnode ? true : false;
+    return find_node(rbt->root, item, rbt) != NULLnode ? true : false;
+}
+
+// returns the element of the red black tree that is equal to given item, or NULL if not found
+Pointer red_black_find(Pointer item, RedBlackTree rbt)
+{
+    rbt_node *node = find_node(rbt->root, item, rbt);
+    return node != NULLnode ? node->data : NULL;
+}
+
+// searches the n keys and stores in out[i] the item equal to keys[i], or NULL if there is none
+// returns the number of keys found
+/* The descents of SEARCH_LANES keys are interleaved, one level per round: in each round every lane compares its key
+   with the item of its current node and moves to a child, which is prefetched, along with the items of the nodes of
+   the next round. So the cache misses of the lanes overlap, instead of every search stalling on each level in turn.
+   A lane whose search ends picks up the next key. */
+size_t red_black_search_batch(Pointer *keys, size_t n, Pointer *out, RedBlackTree rbt)
+{
+    rbt_node *nodes[SEARCH_LANES]; // current node of each lane
+    size_t lane_keys[SEARCH_LANES]; // index of the key searched by each lane
+    size_t found = 0, next = 0, active = 0;
+    if (red_black_is_empty(rbt)){
+        for (size_t i = 0; i < n; i++) out[i] = NULL;
+        return 0;
+    }
+    for (; active < SEARCH_LANES && next < n; active++, next++){
+        nodes[active] = rbt->root;
+        lane_keys[active] = next;
+        out[next] = NULL;
+    }
+    while (active){
+        // the nodes of this round were prefetched in the previous one; now prefetch their items
+        for (size_t i = 0; i < active; i++) PREFETCH(nodes[i]->data);
+        size_t i = 0;
+        while (i < active){
+            size_t key = lane_keys[i];
+            rbt_node *node = nodes[i];
+            int comp_result = compare_items(rbt, keys[key], node->data);
+            if (!comp_result){
+                out[key] = node->data;
+                found++;
+                node = NULLnode;
+            }
+            else node = comp_result < 0 ? node->left : node->right;
+            if (node == NULLnode){
+                // the search of the lane ended; start the next key in it, or else drop the lane
+                if (next == n){
+                    active--;
+                    nodes[i] = nodes[active];
+                    lane_keys[i] = lane_keys[active];
+                    continue;
+                }
+                node = rbt->root;
+                lane_keys[i] = next;
+                out[next++] = NULL;
+            }
+            PREFETCH(node);
+            nodes[i++] = node;
+        }
+    }
+    return found;
 }
 
 // returns the root element of the rbt
@@ -509,6 +1528,62 @@ Pointer red_black_max(RedBlackTree rbt)
     return max->data;
 }
 
+// returns the height (number of levels) of the rbt, 0 if empty
+int red_black_height(RedBlackTree rbt)
+{
+    return tree_height(rbt->root);
+}
+
+// returns the black height of the rbt: the number of black nodes on any path from the root down to a leaf
+int red_black_black_height(RedBlackTree rbt)
+{
+    return black_height(rbt->root);
+}
+
+// stores in histogram[d] the number of nodes at depth d (the root has depth 0), for every d < length
+// returns the height of the rbt; a histogram of that length holds every depth
+int red_black_depth_histogram(RedBlackTree rbt, size_t *histogram, int length)
+{
+    for (int d = 0; d < length; d++) histogram[d] = 0;
+    count_depths(rbt->root, 0, histogram, length);
+    return red_black_height(rbt);
+}
+
+// checks in O(n) that the rbt is valid: items in strictly ascending order, black root,
+// no red node with a red child, equal black height on every path, correct parent pointers and size
+// (if the size isn't known yet, after a split, the count becomes the size)
+bool red_black_verify(RedBlackTree rbt)
+{
+    if (NULLnode->color != BLACK) return false;
+    if (rbt->root != NULLnode && rbt->root->color != BLACK) return false;
+    rbt_node *prev = NULLnode;
+    size_t count = 0;
+    if (verify_nodes(rbt->root, NULLnode, &prev, &count, rbt) < 0) return false;
+    if (rbt->size == SIZE_UNKNOWN) rbt->size = count;
+    return count == rbt->size;
+}
+
+// returns the operation counters of the rbt
+AdtStats red_black_get_stats(RedBlackTree rbt)
+{
+#ifdef ADT_STATS
+    return rbt->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the rbt; the peak size becomes the current size
+void red_black_reset_stats(RedBlackTree rbt)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = red_black_size(rbt);
+    rbt->stats = stats;
+#endif
+}
+
 // sets as new CompareFunc of rbt the given one
 void red_black_set_compare(RedBlackTree rbt, CompareFunc compare)
 {
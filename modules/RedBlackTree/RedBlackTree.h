@@ -3,7 +3,11 @@
 #ifndef RED_BLACK_TREE_H
 #define RED_BLACK_TREE_H
 
+#include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+#include "../Iterators/Iterators.h"
 
 // generic-pointer typedef
 typedef void *Pointer;
@@ -20,9 +24,34 @@ typedef void (*DestroyFunc)(Pointer);
 // pointer to function printing red_black tree's item
 typedef void (*PrintFunc)(Pointer);
 
+// pointer to function that writes given element to given stream
+// returns true if the element was written successfully
+typedef bool (*SerializeFunc)(Pointer, FILE *);
+
+// pointer to function that reads an element, written by a SerializeFunc, from given stream
+// returns NULL if no element could be read
+typedef Pointer (*DeserializeFunc)(FILE *);
+
+// pointer to function that encodes given element into a fixed-size key and a fixed-size value
+// (key and value point to key_size and value_size zeroed bytes respectively)
+typedef void (*EncodeFunc)(Pointer item, Pointer key, Pointer value);
+
+// pointer to function that visits given element, with the context given to the visiting function
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
 // pointer to red black tree
 typedef struct red_black_tree *RedBlackTree;
 
+// iterator over the items of a red black tree (RBTIterator, defined in Iterators.h), in-order (ascending)
+// declared by the user (usually as a local variable); it stays valid as long as the red black tree isn't changed
+
+// pointer to frozen index (see FrozenIndex module)
+typedef struct frozen_index *FrozenIndex;
+
+// pointer to thread pool (see ThreadPool module)
+typedef struct thread_pool *ThreadPool;
+
 /*-----Functions Provided-----*/
 
 // initializes an empty red black tree
@@ -34,14 +63,74 @@ void red_black_insert(Pointer, RedBlackTree);
 // removes and destroys given item from the red black tree
 void red_black_remove(Pointer, RedBlackTree);
 
+// appends the items of b, which must all be greater than the items of a, to a in O(log n)
+// b is destroyed, but not its items; returns false (changing nothing) if the items of the trees overlap
+bool red_black_join(RedBlackTree a, RedBlackTree b);
+
+// splits the red black tree in O(log n): items smaller than given item stay in it and greater ones
+// are moved to a new red black tree, stored in greater (the sizes of the two trees are counted when first needed)
+// returns the item equal to given item (removed but not destroyed), or NULL if there is none
+Pointer red_black_split(Pointer, RedBlackTree, RedBlackTree *greater);
+
+// adds the items of b to a, reusing the nodes of b; b is destroyed, along with its duplicate items
+void red_black_union(RedBlackTree a, RedBlackTree b);
+
+// keeps in a only the items that are also in b; b and all removed items are destroyed
+void red_black_intersect(RedBlackTree a, RedBlackTree b);
+
+// removes from a the items that are also in b; b and all removed items are destroyed
+void red_black_difference(RedBlackTree a, RedBlackTree b);
+
+// inserts the n items of the array like n calls of red_black_insert, sorting them, building them into a tree
+// and merging it into the red black tree in parallel on the threads of given thread pool (NULL: sequentially)
+void red_black_insert_many_parallel(Pointer *items, size_t n, RedBlackTree, ThreadPool);
+
+// red_black_union, run in parallel on the threads of given thread pool (NULL: sequentially)
+void red_black_union_parallel(RedBlackTree a, RedBlackTree b, ThreadPool);
+
+// visits the items of the red black tree in-order (ascending) with given VisitFunc and context
+// stops once a visit returns false
+void red_black_for_each(RedBlackTree, VisitFunc, void *context);
+
+// initializes given iterator at the smallest item of the red black tree
+void red_black_iterator_init(RBTIterator *, RedBlackTree);
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer red_black_iterator_next(RBTIterator *);
+
 // prints items of the red black tree
 void red_black_print(RedBlackTree);
 
 // destroys the given red black tree by freeing all nodes
 void red_black_destroy(RedBlackTree);
 
+// visits the items of the red black tree with given VisitFunc and context, in no particular order,
+// in parallel on the threads of given thread pool (NULL: sequentially, in-order); stops once a visit returns false
+void red_black_for_each_parallel(RedBlackTree, VisitFunc, void *context, ThreadPool);
+
+// red_black_destroy, run in parallel on the threads of given thread pool (NULL: sequentially)
+void red_black_destroy_parallel(RedBlackTree, ThreadPool);
+
+// writes a snapshot of the red black tree to given stream (a header and the items in-order)
+// returns true on success
+bool red_black_save(RedBlackTree, FILE *, SerializeFunc);
+
+// initializes a red black tree from a snapshot written by red_black_save or bst_save, in O(n)
+// returns false if the snapshot can't be read; the tree is then initialized empty
+bool red_black_load(RedBlackTree *, FILE *, DeserializeFunc, CompareFunc, DestroyFunc, PrintFunc);
+
+// turns the red black tree into a read-only frozen index (see FrozenIndex module), in O(n)
+// the tree is destroyed and its items are moved to the frozen index
+FrozenIndex red_black_freeze(RedBlackTree);
+
+// writes the items of the red black tree to an index file, that can be opened with mi_open (see MappedIndex module)
+// the EncodeFunc must encode the items into keys of key_size bytes, preserving their order, and values of value_size bytes
+// returns true on success
+bool red_black_export(RedBlackTree, const char *path, EncodeFunc, int key_size, int value_size);
+
 // returns the number of elements in the red black tree
-int red_black_size(RedBlackTree);
+// O(1), except for the first call after a split, which counts the items in O(n)
+size_t red_black_size(RedBlackTree);
 
 // returns true/false depending on if red black tree is empty or not
 bool red_black_is_empty(RedBlackTree);
@@ -49,6 +138,14 @@ bool red_black_is_empty(RedBlackTree);
 // returns true/false based on if given item is found in the red black tree or not
 bool red_black_search(Pointer, RedBlackTree);
 
+// returns the element of the red black tree that is equal to given item
+// returns NULL if not found
+Pointer red_black_find(Pointer, RedBlackTree);
+
+// searches the n keys with interleaved descents, storing in out[i] the item equal to keys[i] (or NULL)
+// returns the number of keys found
+size_t red_black_search_batch(Pointer *keys, size_t n, Pointer *out, RedBlackTree);
+
 // returns the root element of the red black tree
 Pointer red_black_root(RedBlackTree);
 
@@ -58,6 +155,26 @@ Pointer red_black_min(RedBlackTree);
 // returns the element with highest value
 Pointer red_black_max(RedBlackTree);
 
+// returns the height (number of levels) of the red black tree, 0 if empty
+int red_black_height(RedBlackTree);
+
+// returns the black height of the red black tree (number of black nodes on any path from the root to a leaf)
+int red_black_black_height(RedBlackTree);
+
+// stores in histogram[d] the number of nodes at depth d (root has depth 0), for every d < length
+// returns the height of the red black tree, so a histogram of that length holds all depths
+int red_black_depth_histogram(RedBlackTree, size_t *histogram, int length);
+
+// returns true if the red black tree is valid: items in order, coloring rules, parent pointers and size (O(n))
+// after a split, the size is only counted, and stored
+bool red_black_verify(RedBlackTree);
+
+// returns the operation counters of the red black tree (see Stats.h)
+AdtStats red_black_get_stats(RedBlackTree);
+
+// resets the operation counters of the red black tree
+void red_black_reset_stats(RedBlackTree);
+
 // sets as new CompareFunc of given red black tree the given one
 void red_black_set_compare(RedBlackTree, CompareFunc);
 
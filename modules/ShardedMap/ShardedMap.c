@@ -0,0 +1,236 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <assert.h>
+#include "ShardedMap.h"
+#include "../RedBlackTree/RedBlackTree.h"
+
+// lock taken by searches: the read lock, unless the trees count their comparisons (STATS=1), which searches
+// would update at the same time without synchronization
+#ifdef ADT_STATS
+#define SEARCH_LOCK(lock) pthread_rwlock_wrlock(lock)
+#else
+#define SEARCH_LOCK(lock) pthread_rwlock_rdlock(lock)
+#endif
+
+// shard struct, aligned to a cache line so that threads working on neighbouring shards don't share one
+typedef struct sm_shard{
+    _Alignas(64) pthread_rwlock_t lock; // taken for reading by searches (see SEARCH_LOCK) and visits, for writing by inserts and removes
+    RedBlackTree tree; // the items of the shard
+}sm_shard;
+
+// sharded map struct
+/* The items are partitioned by the ShardFunc into independent red black trees, each behind its own rwlock,
+   so inserts and removes of different shards run in parallel, and searches of any shard run in parallel.
+   A shard doesn't keep a whole key range (unless the ShardFunc partitions by range), so a visit in order
+   read-locks all the shards and merges them on the fly (k-way merge): a binary heap holds the next item of
+   every shard, and the smallest one is visited and replaced by the following item of its shard.          */
+struct sharded_map{
+    sm_shard *shards; // array of the shards
+    int shard_count; // number of shards
+    ShardFunc Shard;
+    CompareFunc Compare;
+    DestroyFunc Destroy;
+    PrintFunc Print;
+};
+
+// merge state of an ordered visit
+typedef struct sm_merge{
+    RBTIterator *iterators; // iterator of every shard
+    Pointer *next; // next item of every shard
+    int *heap; // binary heap of the shards with items left, ordered by their next item
+    int count; // number of shards in the heap
+    CompareFunc Compare;
+}sm_merge;
+
+// shard functions
+
+// returns the shard of given item
+static sm_shard *get_shard(Pointer item, ShardedMap sm)
+{
+    return &sm->shards[sm->Shard(item) % sm->shard_count];
+}
+
+// returns true if the next item of shard a is smaller than the next item of shard b
+static bool merge_less(sm_merge *merge, int a, int b)
+{
+    return merge->Compare(merge->next[a], merge->next[b]) < 0;
+}
+
+// moves the shard at given position of the heap down, until it's not greater than its children
+static void merge_sift_down(sm_merge *merge, int position)
+{
+    int *heap = merge->heap;
+    while (true){
+        int smallest = position, left = 2 * position + 1, right = left + 1;
+        if (left < merge->count && merge_less(merge, heap[left], heap[smallest])) smallest = left;
+        if (right < merge->count && merge_less(merge, heap[right], heap[smallest])) smallest = right;
+        if (smallest == position) return;
+        int shard = heap[position];
+        heap[position] = heap[smallest];
+        heap[smallest] = shard;
+        position = smallest;
+    }
+}
+
+// Sharded Map ADT functions
+
+// initializes an empty sharded map with given number of shards
+void sm_initialize(ShardedMap *sm, int shards, ShardFunc shard, CompareFunc compare, DestroyFunc destroy, PrintFunc print)
+{
+    assert(shards > 0);
+    *sm = malloc(sizeof(struct sharded_map));
+    assert(*sm);
+    (*sm)->shards = aligned_alloc(_Alignof(sm_shard), shards * sizeof(sm_shard));
+    assert((*sm)->shards);
+    (*sm)->shard_count = shards;
+    for (int i = 0; i < shards; i++){
+        pthread_rwlock_init(&(*sm)->shards[i].lock, NULL);
+        red_black_initialize(&(*sm)->shards[i].tree, compare, destroy, NULL);
+    }
+    (*sm)->Shard = shard;
+    (*sm)->Compare = compare;
+    sm_set_destroy(*sm, destroy);
+    sm_set_print(*sm, print);
+}
+
+// inserts given item in the map
+// returns false if an equal item is already in the map
+bool sm_insert(Pointer item, ShardedMap sm)
+{
+    sm_shard *shard = get_shard(item, sm);
+    pthread_rwlock_wrlock(&shard->lock);
+    size_t size = red_black_size(shard->tree);
+    red_black_insert(item, shard->tree);
+    bool inserted = red_black_size(shard->tree) != size;
+    pthread_rwlock_unlock(&shard->lock);
+    return inserted;
+}
+
+// removes and destroys the item equal to given item from the map
+// returns false if there is no equal item in the map
+bool sm_remove(Pointer item, ShardedMap sm)
+{
+    sm_shard *shard = get_shard(item, sm);
+    pthread_rwlock_wrlock(&shard->lock);
+    size_t size = red_black_size(shard->tree);
+    red_black_remove(item, shard->tree);
+    bool removed = red_black_size(shard->tree) != size;
+    pthread_rwlock_unlock(&shard->lock);
+    return removed;
+}
+
+// returns true/false based on if given item is found in the map or not
+bool sm_search(Pointer item, ShardedMap sm)
+{
+    return sm_find(item, sm) != NULL ? true : false;
+}
+
+// returns the item of the map that is equal to given item, or NULL if there is none
+Pointer sm_find(Pointer item, ShardedMap sm)
+{
+    sm_shard *shard = get_shard(item, sm);
+    SEARCH_LOCK(&shard->lock);
+    Pointer found = red_black_find(item, shard->tree);
+    pthread_rwlock_unlock(&shard->lock);
+    return found;
+}
+
+// visits all the items of the map in ascending order with given VisitFunc, until a visit returns false
+void sm_for_each(ShardedMap sm, VisitFunc visit, void *context)
+{
+    int shards = sm->shard_count;
+    sm_merge merge;
+    merge.iterators = malloc(shards * sizeof(RBTIterator));
+    merge.next = malloc(shards * sizeof(Pointer));
+    merge.heap = malloc(shards * sizeof(int));
+    assert(merge.iterators && merge.next && merge.heap);
+    merge.count = 0;
+    merge.Compare = sm->Compare;
+    // lock all the shards (always in the same order) and start from the smallest item of each one
+    for (int i = 0; i < shards; i++){
+        pthread_rwlock_rdlock(&sm->shards[i].lock);
+        red_black_iterator_init(&merge.iterators[i], sm->shards[i].tree);
+        merge.next[i] = red_black_iterator_next(&merge.iterators[i]);
+        if (merge.next[i] != NULL) merge.heap[merge.count++] = i;
+    }
+    for (int position = merge.count / 2 - 1; position >= 0; position--) merge_sift_down(&merge, position);
+    // visit the smallest next item, and replace it by the following item of its shard
+    while (merge.count > 0){
+        int shard = merge.heap[0];
+        if (!visit(merge.next[shard], context)) break;
+        merge.next[shard] = red_black_iterator_next(&merge.iterators[shard]);
+        if (merge.next[shard] == NULL) merge.heap[0] = merge.heap[--merge.count];
+        merge_sift_down(&merge, 0);
+    }
+    for (int i = shards - 1; i >= 0; i--) pthread_rwlock_unlock(&sm->shards[i].lock);
+    free(merge.iterators);
+    free(merge.next);
+    free(merge.heap);
+}
+
+// visit function of sm_print: prints given item with the PrintFunc of the map
+static bool print_item(Pointer item, void *context)
+{
+    ShardedMap sm = context;
+    sm->Print(item);
+    return true;
+}
+
+// prints items of the map based on given PrintFunc, in ascending order
+void sm_print(ShardedMap sm)
+{
+    // check if a PrintFunc exists and if map isn't empty
+    if (sm->Print == NULL || sm_is_empty(sm)) return;
+    sm_for_each(sm, print_item, sm);
+    printf("\n");
+}
+
+// destroys the given map
+void sm_destroy(ShardedMap sm)
+{
+    for (int i = 0; i < sm->shard_count; i++){
+        red_black_destroy(sm->shards[i].tree);
+        pthread_rwlock_destroy(&sm->shards[i].lock);
+    }
+    free(sm->shards);
+    free(sm);
+}
+
+// returns the number of elements in the map
+size_t sm_size(ShardedMap sm)
+{
+    size_t size = 0;
+    for (int i = 0; i < sm->shard_count; i++){
+        pthread_rwlock_rdlock(&sm->shards[i].lock);
+        size += red_black_size(sm->shards[i].tree);
+        pthread_rwlock_unlock(&sm->shards[i].lock);
+    }
+    return size;
+}
+
+// returns true/false depending on if map is empty or not
+bool sm_is_empty(ShardedMap sm)
+{
+    if (!sm_size(sm)) return true;
+    else return false;
+}
+
+// returns the number of shards of the map
+int sm_shards(ShardedMap sm)
+{
+    return sm->shard_count;
+}
+
+// sets as new DestroyFunc of given map the given one
+void sm_set_destroy(ShardedMap sm, DestroyFunc destroy)
+{
+    sm->Destroy = destroy;
+    for (int i = 0; i < sm->shard_count; i++) red_black_set_destroy(sm->shards[i].tree, destroy);
+}
+
+// sets as new PrintFunc of given map the given one
+void sm_set_print(ShardedMap sm, PrintFunc print)
+{
+    sm->Print = print;
+}
@@ -0,0 +1,85 @@
+/* Interface file of (concurrent) Sharded Map ADT */
+
+#ifndef SHARDED_MAP_H
+#define SHARDED_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+/* pointer to function that compares two elements a and b. Returns:
+   < 0 if a < b
+   = 0 if a = b (based on given comparison)
+   > 0 if a > b                                                   */
+typedef int (*CompareFunc)(Pointer a, Pointer b);
+
+// pointer to function that returns the shard of given element (a hash of it, or the number of its key range),
+// taken modulo the number of shards; equal elements must have the same shard
+typedef size_t (*ShardFunc)(Pointer);
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to function printing map's item
+typedef void (*PrintFunc)(Pointer);
+
+// pointer to function that visits given element, with the context given to the visiting function
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
+// pointer to sharded map
+typedef struct sharded_map *ShardedMap;
+
+/*-----Functions Provided-----*/
+/* sm_insert, sm_remove, sm_search, sm_find, sm_for_each, sm_size and sm_is_empty can be called by many threads
+   at the same time on the same map. Operations on items of different shards don't block each other, and reads
+   of the same shard don't block each other either (except for searches when compiled with STATS=1, which lock
+   the shard exclusively, since they update its comparison counters). The other functions need exclusive access. */
+
+// initializes an empty sharded map with given number of shards (at least 1)
+void sm_initialize(ShardedMap *, int shards, ShardFunc, CompareFunc, DestroyFunc, PrintFunc);
+
+// inserts given item in the map
+// returns false if an equal item is already in the map (given item is then not inserted)
+bool sm_insert(Pointer, ShardedMap);
+
+// removes and destroys the item equal to given item from the map
+// returns false if there is no equal item in the map
+bool sm_remove(Pointer, ShardedMap);
+
+// returns true/false based on if given item is found in the map or not
+bool sm_search(Pointer, ShardedMap);
+
+// returns the item of the map that is equal to given item, or NULL if there is none
+// (the returned item may be removed and destroyed by another thread at any time after the call)
+Pointer sm_find(Pointer, ShardedMap);
+
+// visits all the items of the map in ascending order with given VisitFunc and context, until a visit returns false
+// the shards are merged on the fly; the visit sees a snapshot of the map, which can't change until it ends
+// (so VisitFunc must not change the map)
+void sm_for_each(ShardedMap, VisitFunc, void *context);
+
+// prints items of the map in ascending order
+void sm_print(ShardedMap);
+
+// destroys the given map, along with its items
+void sm_destroy(ShardedMap);
+
+// returns the number of elements in the map
+size_t sm_size(ShardedMap);
+
+// returns true/false depending on if map is empty or not
+bool sm_is_empty(ShardedMap);
+
+// returns the number of shards of the map
+int sm_shards(ShardedMap);
+
+// sets as new DestroyFunc of given map the given one
+void sm_set_destroy(ShardedMap, DestroyFunc);
+
+// sets as new PrintFunc of given map the given one
+void sm_set_print(ShardedMap, PrintFunc);
+
+#endif
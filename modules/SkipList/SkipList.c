@@ -0,0 +1,398 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <assert.h>
+#include "SkipList.h"
+#include "../Epoch/Epoch.h"
+
+// max number of levels of a node; with a 1/4 chance of every extra level, it's enough for 4^MAX_LEVEL items
+#define MAX_LEVEL 24
+
+// number of size counters; every thread updates one of them, so that they don't all write the same cache line
+#define SIZE_STRIPES 16
+
+// bit of a next pointer that marks its node as removed from that level
+#define MARK ((uintptr_t)1)
+
+#ifdef __GNUC__
+#define TRAILING_ZEROS(x) __builtin_ctzll(x)
+#else
+// returns the number of trailing zero bits of x (x must not be 0)
+static int TRAILING_ZEROS(uint64_t x)
+{
+    int zeros = 0;
+    while (!(x & 1)){
+        x >>= 1;
+        zeros++;
+    }
+    return zeros;
+}
+#endif
+
+// skip list node struct
+typedef struct sl_node{
+    Pointer data; // pointer to the node data
+    int height; // number of levels the node is linked in
+    atomic_int refs; // 2 while the node is being inserted, 1 while it's in the list; retired when it drops to 0
+    _Atomic uintptr_t next[]; // pointers to the next node of every level, along with their MARK bits
+}sl_node;
+
+// size counter, alone in its cache line
+typedef struct size_stripe{
+    atomic_long count; // number of items inserted minus the number of items removed through the stripe
+    char padding[64 - sizeof(atomic_long)];
+}size_stripe;
+
+// skip list struct
+/* Lock-free skip list (Harris, Fraser): the next pointer of every level is updated with compare-and-swap only.
+   An item is removed by first setting the MARK bit of its node's next pointers, top level first; the node is
+   logically removed once the bottom level is marked, by the one thread that manages to mark it. Every traversal
+   that finds a marked node unlinks it from the previous node of that level, so a node is physically removed by
+   the remover, or any other thread passing by. Inserting links the node at the bottom level first, which makes
+   it present, and then at the upper levels. Removed nodes may still be read by other threads, so every operation
+   is a critical section of the list's epoch domain, and removed nodes are retired to it: they (and their items)
+   are destroyed once the operations that could have seen them are over. An inserter still linking the upper
+   levels may link a node that is being removed, after its remover unlinked it; so a node is only retired by
+   the last of its inserter and remover, after a search that unlinks it from every level again.              */
+struct skip_list{
+    sl_node *head; // dummy head node, linked in all levels, with a NULL item
+    EpochDomain epoch; // epoch domain of the operations, where removed nodes are retired
+    bool owns_epoch; // true if the domain was created for the list, and is destroyed with it
+    size_stripe size[SIZE_STRIPES]; // the number of elements is the sum of the counters
+    CompareFunc Compare;
+    DestroyFunc Destroy;
+    PrintFunc Print;
+};
+
+// the stripe of the size counters and the random number generator state of the calling thread
+static _Thread_local unsigned thread_stripe;
+static _Thread_local uint64_t thread_random;
+static atomic_uint thread_count;
+
+// node functions
+
+// returns the node of given next pointer, without its MARK bit
+static sl_node *get_node(uintptr_t next)
+{
+    return (sl_node *)(next & ~MARK);
+}
+
+// returns true if given next pointer is marked
+static bool is_marked(uintptr_t next)
+{
+    return next & MARK;
+}
+
+// creates a new node with given item and height
+static sl_node *create_node(Pointer item, int height)
+{
+    sl_node *node = malloc(sizeof(sl_node) + height * sizeof(_Atomic uintptr_t));
+    assert(node);
+    node->data = item;
+    node->height = height;
+    atomic_init(&node->refs, 2);
+    for (int level = 0; level < height; level++) atomic_init(&node->next[level], 0);
+    return node;
+}
+
+// returns the size stripe of the calling thread (assigned once per thread, round-robin)
+static size_stripe *get_stripe(SkipList sl)
+{
+    if (thread_random == 0){
+        thread_stripe = atomic_fetch_add_explicit(&thread_count, 1, memory_order_relaxed);
+        // the random generator is seeded from the thread's number and the address of its state
+        thread_random = ((uint64_t)thread_stripe + 1) * 0x9E3779B97F4A7C15ULL ^ (uintptr_t)&thread_random;
+        if (thread_random == 0) thread_random = 1;
+    }
+    return &sl->size[thread_stripe % SIZE_STRIPES];
+}
+
+// returns a random height for a new node: every level above the first one is added with probability 1/4
+static int random_height(void)
+{
+    // xorshift64 generator of the calling thread (seeded by get_stripe)
+    thread_random ^= thread_random << 13;
+    thread_random ^= thread_random >> 7;
+    thread_random ^= thread_random << 17;
+    int height = 1 + TRAILING_ZEROS(thread_random | (1ULL << (2 * (MAX_LEVEL - 1)))) / 2;
+    return height;
+}
+
+// finds the nodes before (preds) and after (succs) the position of given item in every level,
+// unlinking the marked nodes found on the way
+// returns -1 if a node couldn't be unlinked because the list changed (the search must be repeated),
+// else 1 if succs[0] holds an item equal to given item, 0 if it doesn't
+static int try_find(Pointer item, sl_node **preds, sl_node **succs, SkipList sl)
+{
+    sl_node *pred = sl->head;
+    int comp_result = 1;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--){
+        sl_node *curr = get_node(atomic_load(&pred->next[level]));
+        comp_result = 1;
+        while (curr != NULL){
+            uintptr_t succ = atomic_load(&curr->next[level]);
+            if (is_marked(succ)){
+                // curr is removed; unlink it from this level
+                uintptr_t expected = (uintptr_t)curr;
+                if (!atomic_compare_exchange_strong(&pred->next[level], &expected, succ & ~MARK)) return -1;
+                curr = get_node(succ);
+                continue;
+            }
+            comp_result = sl->Compare(curr->data, item);
+            if (comp_result >= 0) break;
+            pred = curr;
+            curr = get_node(succ);
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return succs[0] != NULL && !comp_result;
+}
+
+// try_find, repeated until it succeeds
+// returns true if succs[0] holds an item equal to given item
+static bool find(Pointer item, sl_node **preds, sl_node **succs, SkipList sl)
+{
+    int found;
+    while ((found = try_find(item, preds, succs, sl)) < 0);
+    return found;
+}
+
+// returns the first node with an item not smaller than given item (or the first node, if item is NULL),
+// or NULL if there is none, without changing the list
+static sl_node *lower_bound(Pointer item, SkipList sl)
+{
+    sl_node *pred = sl->head, *curr = NULL;
+    for (int level = MAX_LEVEL - 1; level >= 0; level--){
+        curr = get_node(atomic_load(&pred->next[level]));
+        while (curr != NULL && item != NULL){
+            uintptr_t succ = atomic_load(&curr->next[level]);
+            // removed nodes are skipped
+            if (!is_marked(succ) && sl->Compare(curr->data, item) >= 0) break;
+            if (!is_marked(succ)) pred = curr;
+            curr = get_node(succ);
+        }
+    }
+    // skip removed nodes of the bottom level
+    while (curr != NULL && is_marked(atomic_load(&curr->next[0]))) curr = get_node(atomic_load(&curr->next[0]));
+    return curr;
+}
+
+// drops a reference to a removed node; the last one retires the node and its item to the epoch domain
+// (the node must have been unlinked from all levels after it was linked for the last time)
+static void release_node(sl_node *node, SkipList sl)
+{
+    if (atomic_fetch_sub(&node->refs, 1) != 1) return;
+    if (sl->Destroy != NULL) ep_retire(node->data, sl->Destroy, sl->epoch);
+    ep_retire(node, free, sl->epoch);
+}
+
+// links a node that was just inserted in the bottom level in its upper levels, where preds and succs are its neighbours
+static void link_upper_levels(sl_node *node, sl_node **preds, sl_node **succs, SkipList sl)
+{
+    for (int level = 1; level < node->height; level++){
+        while (true){
+            uintptr_t next = atomic_load(&node->next[level]);
+            // the node is already being removed; it's not linked any further
+            if (is_marked(next)) return;
+            if (get_node(next) != succs[level] && !atomic_compare_exchange_strong(&node->next[level], &next, (uintptr_t)succs[level])) return;
+            uintptr_t expected = (uintptr_t)succs[level];
+            if (atomic_compare_exchange_strong(&preds[level]->next[level], &expected, (uintptr_t)node)) break;
+            // the neighbours changed; find them again
+            if (!find(node->data, preds, succs, sl) || succs[0] != node) return;
+        }
+    }
+}
+
+// Skip List ADT functions
+
+// initializes an empty skip list, with an epoch domain of its own
+// returns false if the domain can't be created; the list is then NULL
+bool sl_initialize(SkipList *sl, CompareFunc compare, DestroyFunc destroy, PrintFunc print)
+{
+    EpochDomain epoch;
+    if (!ep_initialize(&epoch)){
+        *sl = NULL;
+        return false;
+    }
+    sl_initialize_shared(sl, epoch, compare, destroy, print);
+    (*sl)->owns_epoch = true;
+    return true;
+}
+
+// initializes an empty skip list that retires its removed nodes to given epoch domain
+void sl_initialize_shared(SkipList *sl, EpochDomain epoch, CompareFunc compare, DestroyFunc destroy, PrintFunc print)
+{
+    *sl = malloc(sizeof(struct skip_list));
+    assert(*sl);
+    (*sl)->head = create_node(NULL, MAX_LEVEL);
+    (*sl)->epoch = epoch;
+    (*sl)->owns_epoch = false;
+    for (int i = 0; i < SIZE_STRIPES; i++) atomic_init(&(*sl)->size[i].count, 0);
+    (*sl)->Compare = compare;
+    sl_set_destroy(*sl, destroy);
+    sl_set_print(*sl, print);
+}
+
+// inserts given item in the skip list
+// returns false if an equal item is already in the list
+bool sl_insert(Pointer item, SkipList sl)
+{
+    sl_node *preds[MAX_LEVEL], *succs[MAX_LEVEL];
+    size_stripe *stripe = get_stripe(sl);
+    sl_node *node = NULL;
+    ep_enter(sl->epoch);
+    while (true){
+        if (find(item, preds, succs, sl)){
+            ep_exit(sl->epoch);
+            free(node);
+            return false;
+        }
+        if (node == NULL) node = create_node(item, random_height());
+        for (int level = 0; level < node->height; level++) atomic_store_explicit(&node->next[level], (uintptr_t)succs[level], memory_order_relaxed);
+        // the item is in the list once its node is linked in the bottom level
+        uintptr_t expected = (uintptr_t)succs[0];
+        if (atomic_compare_exchange_strong(&preds[0]->next[0], &expected, (uintptr_t)node)) break;
+    }
+    atomic_fetch_add_explicit(&stripe->count, 1, memory_order_relaxed);
+    link_upper_levels(node, preds, succs, sl);
+    // if the node was removed meanwhile, it may have been linked after its remover unlinked it
+    if (is_marked(atomic_load(&node->next[0]))) find(item, preds, succs, sl);
+    release_node(node, sl);
+    ep_exit(sl->epoch);
+    return true;
+}
+
+// removes given item from the skip list
+// returns false if there is no equal item in the list
+bool sl_remove(Pointer item, SkipList sl)
+{
+    sl_node *preds[MAX_LEVEL], *succs[MAX_LEVEL];
+    size_stripe *stripe = get_stripe(sl);
+    ep_enter(sl->epoch);
+    if (!find(item, preds, succs, sl)){
+        ep_exit(sl->epoch);
+        return false;
+    }
+    sl_node *node = succs[0];
+    // mark the upper levels, from the top one down
+    for (int level = node->height - 1; level > 0; level--) atomic_fetch_or(&node->next[level], MARK);
+    // the thread that marks the bottom level removes the item
+    uintptr_t next = atomic_load(&node->next[0]);
+    do{
+        if (is_marked(next)){
+            ep_exit(sl->epoch);
+            return false;
+        }
+    }while (!atomic_compare_exchange_weak(&node->next[0], &next, next | MARK));
+    atomic_fetch_sub_explicit(&stripe->count, 1, memory_order_relaxed);
+    // unlink the node from all levels
+    find(item, preds, succs, sl);
+    release_node(node, sl);
+    ep_exit(sl->epoch);
+    return true;
+}
+
+// returns true/false based on if given item is found in the skip list or not
+bool sl_search(Pointer item, SkipList sl)
+{
+    return sl_find(item, sl) != NULL ? true : false;
+}
+
+// returns the item of the skip list that is equal to given item, or NULL if there is none
+Pointer sl_find(Pointer item, SkipList sl)
+{
+    ep_enter(sl->epoch);
+    sl_node *node = lower_bound(item, sl);
+    Pointer found = node != NULL && !sl->Compare(node->data, item) ? node->data : NULL;
+    ep_exit(sl->epoch);
+    return found;
+}
+
+// visits the items from low to high (inclusive) in ascending order with given VisitFunc, until a visit returns false
+// returns the number of visited items
+size_t sl_range(Pointer low, Pointer high, VisitFunc visit, void *context, SkipList sl)
+{
+    size_t visited = 0;
+    ep_enter(sl->epoch);
+    for (sl_node *node = lower_bound(low, sl); node != NULL; node = get_node(atomic_load(&node->next[0]))){
+        // skip removed nodes
+        if (is_marked(atomic_load(&node->next[0]))) continue;
+        if (high != NULL && sl->Compare(node->data, high) > 0) break;
+        visited++;
+        if (!visit(node->data, context)) break;
+    }
+    ep_exit(sl->epoch);
+    return visited;
+}
+
+// visits the items of the skip list in ascending order with given VisitFunc, until a visit returns false
+void sl_for_each(SkipList sl, VisitFunc visit, void *context)
+{
+    sl_range(NULL, NULL, visit, context, sl);
+}
+
+// prints items of the skip list based on given PrintFunc
+void sl_print(SkipList sl)
+{
+    // check if a PrintFunc exists and if skip list isn't empty
+    if (sl->Print == NULL || sl_is_empty(sl)) return;
+    for (sl_node *node = get_node(atomic_load(&sl->head->next[0])); node != NULL; node = get_node(atomic_load(&node->next[0]))){
+        if (!is_marked(atomic_load(&node->next[0]))) sl->Print(node->data);
+    }
+    printf("\n");
+}
+
+// destroys the given skip list
+void sl_destroy(SkipList sl)
+{
+    // the nodes of the bottom level hold the items of the list; marked ones are already retired
+    sl_node *node = get_node(atomic_load(&sl->head->next[0]));
+    while (node != NULL){
+        uintptr_t next = atomic_load(&node->next[0]);
+        if (!is_marked(next)){
+            if (sl->Destroy != NULL) sl->Destroy(node->data);
+            free(node);
+        }
+        node = get_node(next);
+    }
+    // the removed nodes retired to a shared domain are destroyed by it
+    if (sl->owns_epoch) ep_destroy(sl->epoch);
+    free(sl->head);
+    free(sl);
+}
+
+// returns the epoch domain of the skip list
+EpochDomain sl_epoch(SkipList sl)
+{
+    return sl->epoch;
+}
+
+// returns the number of elements in the skip list
+size_t sl_size(SkipList sl)
+{
+    long size = 0;
+    for (int i = 0; i < SIZE_STRIPES; i++) size += atomic_load_explicit(&sl->size[i].count, memory_order_relaxed);
+    // while items are inserted and removed by other threads, the sum may be momentarily negative
+    return size > 0 ? size : 0;
+}
+
+// returns true/false depending on if skip list is empty or not
+bool sl_is_empty(SkipList sl)
+{
+    if (!sl_size(sl)) return true;
+    else return false;
+}
+
+// sets as new DestroyFunc of given skip list the given one
+void sl_set_destroy(SkipList sl, DestroyFunc destroy)
+{
+    sl->Destroy = destroy;
+}
+
+// sets as new PrintFunc of given skip list the given one
+void sl_set_print(SkipList sl, PrintFunc print)
+{
+    sl->Print = print;
+}
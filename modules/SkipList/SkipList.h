@@ -0,0 +1,96 @@
+/* Interface file of (lock-free) Skip List ADT */
+
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+/* pointer to function that compares two elements a and b. Returns:
+   < 0 if a < b
+   = 0 if a = b (based on given comparison)
+   > 0 if a > b                                                   */
+typedef int (*CompareFunc)(Pointer a, Pointer b);
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to function printing skip list's item
+typedef void (*PrintFunc)(Pointer);
+
+// pointer to function that visits given element, with the context given to the visiting function
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
+// pointer to skip list
+typedef struct skip_list *SkipList;
+
+// pointer to epoch domain (see Epoch.h)
+typedef struct epoch_domain *EpochDomain;
+
+/*-----Functions Provided-----*/
+/* sl_insert, sl_remove, sl_search, sl_find, sl_range, sl_for_each and sl_size can be called by many threads at the same
+   time on the same skip list, without any locks. Traversals see every item that is in the list for their whole duration,
+   and may or may not see items that are inserted or removed meanwhile. The other functions need exclusive access.
+   A removed item is destroyed once no operation can still be reading it; an item returned by sl_find, or visited by
+   sl_range, may be destroyed after the call returns, unless the call is made inside ep_enter/ep_exit of sl_epoch.
+   An epoch domain takes a pthread key, so at most PTHREAD_KEYS_MAX (usually 1024) lists initialized with sl_initialize
+   can exist at the same time; any number of lists can share one domain, through sl_initialize_shared.             */
+
+// initializes an empty skip list, with an epoch domain of its own (destroyed along with the list)
+// returns false if the domain can't be created, since the program has run out of pthread keys; the list is then NULL
+bool sl_initialize(SkipList *, CompareFunc, DestroyFunc, PrintFunc);
+
+// initializes an empty skip list that uses given epoch domain, which can be shared by many containers
+// the domain must outlive the list; the items removed from the list are destroyed by the domain, even after sl_destroy
+void sl_initialize_shared(SkipList *, EpochDomain, CompareFunc, DestroyFunc, PrintFunc);
+
+// inserts given item in the skip list
+// returns false if an equal item is already in the list (given item is then not inserted)
+bool sl_insert(Pointer, SkipList);
+
+// removes given item from the skip list
+// the item is destroyed when its node is reclaimed, once the operations of other threads that may still read it are over
+// returns false if there is no equal item in the list
+bool sl_remove(Pointer, SkipList);
+
+// returns true/false based on if given item is found in the skip list or not
+bool sl_search(Pointer, SkipList);
+
+// returns the item of the skip list that is equal to given item, or NULL if there is none
+Pointer sl_find(Pointer, SkipList);
+
+// visits the items from low to high (inclusive) in ascending order with given VisitFunc and context
+// NULL low/high means no lower/upper limit; stops once a visit returns false
+// returns the number of visited items
+size_t sl_range(Pointer low, Pointer high, VisitFunc, void *context, SkipList);
+
+// visits the items of the skip list in ascending order with given VisitFunc and context
+// stops once a visit returns false
+void sl_for_each(SkipList, VisitFunc, void *context);
+
+// prints items of the skip list
+void sl_print(SkipList);
+
+// destroys the given skip list, along with its items and, if its epoch domain is its own, the removed items that aren't destroyed yet
+void sl_destroy(SkipList);
+
+// returns the epoch domain of the skip list; its critical sections keep the items read meanwhile from being destroyed
+EpochDomain sl_epoch(SkipList);
+
+// returns the number of elements in the skip list
+size_t sl_size(SkipList);
+
+// returns true/false depending on if skip list is empty or not
+bool sl_is_empty(SkipList);
+
+// sets as new DestroyFunc of given skip list the given one
+void sl_set_destroy(SkipList, DestroyFunc);
+
+// sets as new PrintFunc of given skip list the given one
+void sl_set_print(SkipList, PrintFunc);
+
+#endif
@@ -3,16 +3,28 @@
 #include <assert.h>
 #include "Stack.h"
 
-// stack node struct
-typedef struct stack_node{
-    Pointer data; // pointer to the node data
-    struct stack_node *next; // pointer to the next stack node
-}stack_node;
+// number of items held by every block of the stack
+#define STACK_BLOCK_ITEMS 32
+
+// stack block struct
+typedef struct stack_block{
+    Pointer items[STACK_BLOCK_ITEMS]; // items of the block, from the bottom to the top
+    int count; // number of items in the block
+    struct stack_block *next; // pointer to the block below
+}stack_block;
 
 // stack struct
+/* The items are kept in an unrolled linked list: every block holds up to STACK_BLOCK_ITEMS items, and only the
+   top block can be partially full. So a push or pop allocates or frees a block only once every STACK_BLOCK_ITEMS
+   operations, and traversals read consecutive items instead of following a pointer for each one. An emptied
+   block is kept as a spare, so that pushes and pops alternating at a block boundary don't allocate every time. */
 struct stack_struct{
-    stack_node *top; // pointer to the top node of the stack
-    int size; // number of elements in the stack
+    stack_block *top; // pointer to the top block of the stack (NULL if the stack has no blocks)
+    stack_block *spare; // an empty block, kept for the next push that needs one (or NULL)
+    size_t size; // number of elements in the stack
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
     DestroyFunc Destroy;
     PrintFunc Print;
 };
@@ -25,7 +37,9 @@ void stack_initialize(Stack *stack, DestroyFunc destroy_func, PrintFunc print_fu
     (*stack) = malloc(sizeof(struct stack_struct));
     assert(*stack);
     (*stack)->top = NULL;
+    (*stack)->spare = NULL;
     (*stack)->size = 0;
+    stack_reset_stats(*stack);
     stack_set_destroy(*stack, destroy_func);
     stack_set_print(*stack, print_func);
 }
@@ -33,12 +47,23 @@ void stack_initialize(Stack *stack, DestroyFunc destroy_func, PrintFunc print_fu
 // pushes a new item on top of the stack
 void stack_push(Pointer item, Stack stack)
 { 
-    stack_node *new_node = malloc(sizeof(stack_node));
-    assert(new_node);
+    // check if the top block is full; a new block is placed on top
+    if (stack->top == NULL || stack->top->count == STACK_BLOCK_ITEMS){
+        stack_block *block = stack->spare;
+        if (block != NULL) stack->spare = NULL;
+        else{
+            block = malloc(sizeof(stack_block));
+            assert(block);
+            STATS_INC(stack, allocations);
+        }
+        block->count = 0;
+        block->next = stack->top;
+        stack->top = block;
+    }
+    stack->top->items[stack->top->count++] = item;
     stack->size++;
-    new_node->data = item;
-    new_node->next = stack->top;
-    stack->top = new_node;
+    STATS_INC(stack, inserts);
+    STATS_MAX(stack, peak_size, stack->size);
 }
 
 // pops the top item of the stack and returns a pointer to it
@@ -48,11 +73,49 @@ Pointer stack_pop(Stack stack)
     // check if stack is empty
     if (stack_is_empty(stack)) return NULL;
     // else; pop the top element
-    Pointer item = stack->top->data;
-    stack_node *new_top = stack->top->next;
-    free(stack->top);
+    stack_block *block = stack->top;
+    Pointer item = block->items[--block->count];
     stack->size--;
-    stack->top = new_top;
+    STATS_INC(stack, removes);
+    // an emptied block is removed; it's kept as the spare block, unless there already is one
+    if (!block->count){
+        stack->top = block->next;
+        if (stack->spare == NULL) stack->spare = block;
+        else{
+            free(block);
+            STATS_INC(stack, frees);
+        }
+    }
+    return item;
+}
+
+// visits the items of the stack from the top to the bottom with given VisitFunc, until a visit returns false
+void stack_for_each(Stack stack, VisitFunc visit, void *context)
+{
+    for (stack_block *block = stack->top; block != NULL; block = block->next){
+        for (int i = block->count - 1; i >= 0; i--){
+            if (!visit(block->items[i], context)) return;
+        }
+    }
+}
+
+// initializes given iterator at the top of the stack
+void stack_iterator_init(StackIterator *it, Stack stack)
+{
+    it->block = stack->top;
+    it->index = stack->top != NULL ? stack->top->count : 0;
+}
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer stack_iterator_next(StackIterator *it)
+{
+    if (it->block == NULL) return NULL;
+    Pointer item = it->block->items[--it->index];
+    // move to the top of the next block, if this one is done
+    if (!it->index){
+        it->block = it->block->next;
+        if (it->block != NULL) it->index = it->block->count;
+    }
     return item;
 }
 
@@ -62,10 +125,8 @@ void stack_print(Stack stack)
     // check if a PrintFunc exists and if stack isn't empty
     if (stack->Print == NULL || stack_is_empty(stack)) return;
     // else; print stack's elements 
-    stack_node *node = stack->top;
-    while (node != NULL){
-        stack->Print(node->data);
-        node = node->next;
+    for (stack_block *block = stack->top; block != NULL; block = block->next){
+        for (int i = block->count - 1; i >= 0; i--) stack->Print(block->items[i]);
     }
     printf("\n");
 }
@@ -73,25 +134,22 @@ void stack_print(Stack stack)
 // destroys the given stack
 void stack_destroy(Stack stack)
 {
-    // check if stack is empty
-    if (stack_is_empty(stack)){
-        free(stack);
-        return;
-    }
-    // else; destroy stack's elements 
-    stack_node *node = stack->top->next;
-    while (!stack_is_empty(stack)){
-        if (stack->Destroy != NULL) stack->Destroy(stack->top->data);
-        free(stack->top);
-        stack->top = node;
-        if (node != NULL) node = node->next;
-        stack->size--;
+    // destroy stack's elements and blocks
+    stack_block *block = stack->top;
+    while (block != NULL){
+        stack_block *next = block->next;
+        if (stack->Destroy != NULL){
+            for (int i = block->count - 1; i >= 0; i--) stack->Destroy(block->items[i]);
+        }
+        free(block);
+        block = next;
     }
+    free(stack->spare);
     free(stack);
 }
 
 // returns the number of elements in the stack
-int stack_size(Stack stack)
+size_t stack_size(Stack stack)
 {
     return stack->size;
 }
@@ -108,7 +166,28 @@ bool stack_is_empty(Stack stack)
 Pointer stack_top(Stack stack)
 {
     if (stack_is_empty(stack)) return NULL;
-    return stack->top->data;
+    return stack->top->items[stack->top->count - 1];
+}
+
+// returns the operation counters of the stack
+AdtStats stack_get_stats(Stack stack)
+{
+#ifdef ADT_STATS
+    return stack->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the stack; the peak size becomes the current size
+void stack_reset_stats(Stack stack)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = stack->size;
+    stack->stats = stats;
+#endif
 }
 
 // sets as new DestroyFunc of given stack the given one
@@ -4,6 +4,9 @@
 #define STACK_H
 
 #include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+#include "../Iterators/Iterators.h"
 
 // generic-pointer typedef
 typedef void *Pointer;
@@ -14,9 +17,16 @@ typedef void (*DestroyFunc)(Pointer);
 // pointer to function printing stack's item
 typedef void (*PrintFunc)(Pointer);
 
+// pointer to function that visits given element, with the context given to the visiting function
+// returns false to stop the visit
+typedef bool (*VisitFunc)(Pointer, void *context);
+
 // pointer to stack
 typedef struct stack_struct *Stack;
 
+// iterator over the items of a stack (StackIterator, defined in Iterators.h), from the top to the bottom
+// declared by the user (usually as a local variable); it stays valid as long as the stack isn't changed
+
 /*-----Functions Provided-----*/
 
 // initializes an empty stack
@@ -29,6 +39,16 @@ void stack_push(Pointer, Stack);
 // returns NULL if stack is empty
 Pointer stack_pop(Stack);
 
+// visits the items of the stack from the top to the bottom with given VisitFunc and context
+// stops once a visit returns false
+void stack_for_each(Stack, VisitFunc, void *context);
+
+// initializes given iterator at the top of the stack
+void stack_iterator_init(StackIterator *, Stack);
+
+// returns the next item of the iterator, or NULL after the last one
+Pointer stack_iterator_next(StackIterator *);
+
 // prints items of the stack
 void stack_print(Stack);
 
@@ -36,7 +56,7 @@ void stack_print(Stack);
 void stack_destroy(Stack);
 
 // returns the number of elements in the stack
-int stack_size(Stack);
+size_t stack_size(Stack);
 
 // returns true/false depending on if stack is empty or not
 bool stack_is_empty(Stack);
@@ -45,6 +65,12 @@ bool stack_is_empty(Stack);
 // returns NULL if stack is empty
 Pointer stack_top(Stack);
 
+// returns the operation counters of the stack (see Stats.h)
+AdtStats stack_get_stats(Stack);
+
+// resets the operation counters of the stack
+void stack_reset_stats(Stack);
+
 // sets as new DestroyFunc of given stack the given one
 void stack_set_destroy(Stack, DestroyFunc);
 
@@ -0,0 +1,32 @@
+/* Operation counters shared by the ADT modules */
+
+#ifndef ADT_STATS_H
+#define ADT_STATS_H
+
+/* operation counters of a container
+   the counters are only maintained if the library is compiled with ADT_STATS defined (make lib STATS=1);
+   else the containers don't store them at all and the *_get_stats functions return only zeros          */
+typedef struct adt_stats{
+    unsigned long inserts; // number of inserted items
+    unsigned long removes; // number of removed items
+    unsigned long comparisons; // number of CompareFunc calls
+    unsigned long rotations; // number of tree rotations
+    unsigned long recolorings; // number of recoloring operations (red black tree)
+    unsigned long allocations; // number of allocated nodes (or arrays)
+    unsigned long frees; // number of freed nodes (or arrays)
+    unsigned long peak_size; // max number of items held at the same time
+    unsigned long max_depth; // max depth of an inserted node (trees), where the root has depth 0
+}AdtStats;
+
+// macros used by the modules to update the counters of a container with a stats field
+#ifdef ADT_STATS
+#define STATS_ADD(container, counter, n) ((container)->stats.counter += (n))
+#define STATS_MAX(container, counter, value) \
+    do{ if ((unsigned long)(value) > (container)->stats.counter) (container)->stats.counter = (value); }while(0)
+#else
+#define STATS_ADD(container, counter, n) ((void)0)
+#define STATS_MAX(container, counter, value) ((void)0)
+#endif
+#define STATS_INC(container, counter) STATS_ADD(container, counter, 1)
+
+#endif
@@ -0,0 +1,175 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "ThreadPool.h"
+
+// task struct
+typedef struct tp_task{
+    TaskFunc Run; // function run by the task
+    Pointer arg; // argument of the function
+    bool done; // true after the function returns
+    struct tp_task *next; // pointer to the next pending task
+}tp_task;
+
+// thread pool struct
+/* Pending tasks are kept in a stack: the most recently spawned task runs first, which in fork-join code is
+   usually the subtask that the spawning thread is about to wait for. A thread waiting for a task doesn't block;
+   it keeps running pending tasks until its own task is done, so nested spawns can't exhaust the workers.
+   A spawn wakes one thread, not all of them, and a finished task wakes the threads waiting in tp_wait only if
+   there are any, so the threads don't contend for the lock on every spawn and finish. */
+struct thread_pool{
+    pthread_t *threads; // array of the worker threads
+    int thread_count; // number of worker threads
+    tp_task *pending; // stack of the tasks that haven't started yet
+    bool shutdown; // true when the worker threads should exit
+    int idle; // number of worker threads waiting for a task to be spawned
+    int waiting; // number of threads waiting in tp_wait for a running task to finish
+    pthread_mutex_t lock; // protects the pending stack, the done flags, shutdown and the counters
+    pthread_cond_t spawned; // signaled when a task is spawned (for the idle workers), broadcast when the pool shuts down
+    pthread_cond_t finished; // broadcast when a task finishes while threads wait in tp_wait
+};
+
+// task functions
+
+// removes and returns the most recently spawned pending task, or NULL if there is none
+// the lock of the pool must be held
+static tp_task *pop_task(ThreadPool tp)
+{
+    tp_task *task = tp->pending;
+    if (task != NULL) tp->pending = task->next;
+    return task;
+}
+
+// wakes one thread to run a pending task: an idle worker, or else a thread waiting in tp_wait
+// the lock of the pool must be held
+static void wake_thread(ThreadPool tp)
+{
+    if (tp->idle) pthread_cond_signal(&tp->spawned);
+    else if (tp->waiting) pthread_cond_signal(&tp->finished);
+}
+
+// runs given task and marks it done
+// the lock of the pool must not be held
+static void run_task(tp_task *task, ThreadPool tp)
+{
+    task->Run(task->arg);
+    pthread_mutex_lock(&tp->lock);
+    task->done = true;
+    // only the waiting threads care about finished tasks; it's not known which one waits for this one
+    if (tp->waiting) pthread_cond_broadcast(&tp->finished);
+    pthread_mutex_unlock(&tp->lock);
+}
+
+// main function of a worker thread: runs pending tasks until the pool shuts down
+static void *worker(void *arg)
+{
+    ThreadPool tp = arg;
+    pthread_mutex_lock(&tp->lock);
+    while (true){
+        tp_task *task = pop_task(tp);
+        if (task != NULL){
+            // more tasks may have been spawned before this thread woke up; wake another thread for them
+            if (tp->pending != NULL) wake_thread(tp);
+            pthread_mutex_unlock(&tp->lock);
+            run_task(task, tp);
+            pthread_mutex_lock(&tp->lock);
+        }
+        else if (tp->shutdown) break;
+        else{
+            tp->idle++;
+            pthread_cond_wait(&tp->spawned, &tp->lock);
+            tp->idle--;
+        }
+    }
+    pthread_mutex_unlock(&tp->lock);
+    return NULL;
+}
+
+// Thread Pool ADT functions
+
+// initializes a thread pool with given number of worker threads (one per online processor if threads <= 0)
+void tp_initialize(ThreadPool *tp, int threads)
+{
+    if (threads <= 0){
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = processors > 0 ? processors : 1;
+    }
+    *tp = malloc(sizeof(struct thread_pool));
+    assert(*tp);
+    (*tp)->threads = malloc(threads * sizeof(pthread_t));
+    assert((*tp)->threads);
+    (*tp)->pending = NULL;
+    (*tp)->shutdown = false;
+    (*tp)->idle = 0;
+    (*tp)->waiting = 0;
+    pthread_mutex_init(&(*tp)->lock, NULL);
+    pthread_cond_init(&(*tp)->spawned, NULL);
+    pthread_cond_init(&(*tp)->finished, NULL);
+    (*tp)->thread_count = 0;
+    for (int i = 0; i < threads; i++){
+        if (pthread_create(&(*tp)->threads[i], NULL, worker, *tp)) break;
+        (*tp)->thread_count++;
+    }
+}
+
+// spawns a task that runs given TaskFunc with given argument
+Task tp_spawn(TaskFunc run, Pointer arg, ThreadPool tp)
+{
+    tp_task *task = malloc(sizeof(tp_task));
+    assert(task);
+    task->Run = run;
+    task->arg = arg;
+    task->done = false;
+    pthread_mutex_lock(&tp->lock);
+    task->next = tp->pending;
+    tp->pending = task;
+    wake_thread(tp);
+    pthread_mutex_unlock(&tp->lock);
+    return task;
+}
+
+// waits until given task is finished, running pending tasks in the meantime
+void tp_wait(Task task, ThreadPool tp)
+{
+    pthread_mutex_lock(&tp->lock);
+    while (!task->done){
+        tp_task *pending = pop_task(tp);
+        if (pending != NULL){
+            pthread_mutex_unlock(&tp->lock);
+            run_task(pending, tp);
+            pthread_mutex_lock(&tp->lock);
+        }
+        else{
+            tp->waiting++;
+            pthread_cond_wait(&tp->finished, &tp->lock);
+            tp->waiting--;
+        }
+    }
+    // this thread may have been woken for a spawned task instead of another one; pass the wakeup on
+    if (tp->pending != NULL) wake_thread(tp);
+    pthread_mutex_unlock(&tp->lock);
+    free(task);
+}
+
+// returns the number of worker threads of the thread pool
+int tp_threads(ThreadPool tp)
+{
+    return tp->thread_count;
+}
+
+// destroys the given thread pool
+void tp_destroy(ThreadPool tp)
+{
+    pthread_mutex_lock(&tp->lock);
+    tp->shutdown = true;
+    pthread_cond_broadcast(&tp->spawned);
+    pthread_mutex_unlock(&tp->lock);
+    for (int i = 0; i < tp->thread_count; i++) pthread_join(tp->threads[i], NULL);
+    pthread_mutex_destroy(&tp->lock);
+    pthread_cond_destroy(&tp->spawned);
+    pthread_cond_destroy(&tp->finished);
+    free(tp->threads);
+    free(tp);
+}
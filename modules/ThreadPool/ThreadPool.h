@@ -0,0 +1,42 @@
+/* Interface file of Thread Pool ADT */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdbool.h>
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+// pointer to function that runs a task with given argument
+typedef void (*TaskFunc)(Pointer);
+
+// pointer to thread pool
+typedef struct thread_pool *ThreadPool;
+
+// pointer to a spawned task, used to wait for it
+// a task handle is invalid after tp_wait returns
+typedef struct tp_task *Task;
+
+/*-----Functions Provided-----*/
+
+// initializes a thread pool with given number of worker threads
+// if threads is 0 or negative, a worker thread is started for every online processor
+void tp_initialize(ThreadPool *, int threads);
+
+// spawns a task that runs given TaskFunc with given argument on one of the threads of the pool
+// every spawned task must be waited for with tp_wait
+Task tp_spawn(TaskFunc, Pointer arg, ThreadPool);
+
+// waits until given task is finished; meanwhile the calling thread runs pending tasks of the pool
+// (so tasks can spawn and wait for their own subtasks without blocking the pool)
+void tp_wait(Task, ThreadPool);
+
+// returns the number of worker threads of the thread pool
+int tp_threads(ThreadPool);
+
+// destroys the given thread pool, after its worker threads finish
+// all spawned tasks must have been waited for
+void tp_destroy(ThreadPool);
+
+#endif
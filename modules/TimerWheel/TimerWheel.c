@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "TimerWheel.h"
+
+// every wheel has 2^WHEEL_BITS slots
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+
+// number of wheels; timers further than 2^(WHEEL_BITS * WHEEL_LEVELS) ticks are kept in the last wheel until they come closer
+#define WHEEL_LEVELS 4
+#define MAX_DISTANCE ((1UL << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+// timer struct
+typedef struct tw_timer{
+    Pointer data; // pointer to the timer data
+    unsigned long expires; // tick at which the timer expires
+    struct tw_timer *next, *prev; // pointers to the next and previous timers of the slot
+}tw_timer;
+
+// timer wheel struct
+/* Each slot is a circular doubly-linked list with a dummy head node, so a timer is removed in O(1).
+   Wheel 0 has a slot for each of the next WHEEL_SLOTS ticks and is rotated like a circular list's cursor,
+   one slot per tick. Every slot of wheel i covers WHEEL_SLOTS^i ticks; when the wheel below completes
+   a rotation, the timers of the next slot of wheel i are cascaded (re-scheduled) to the lower wheels. */
+struct timer_wheel{
+    tw_timer slots[WHEEL_LEVELS][WHEEL_SLOTS]; // dummy head nodes of the slots of each wheel
+    unsigned long now; // current time
+    size_t size; // number of pending timers
+#ifdef ADT_STATS
+    AdtStats stats; // operation counters
+#endif
+    ExpireFunc Expire;
+    DestroyFunc Destroy;
+    PrintFunc Print;
+};
+
+// slot functions
+
+// initializes an empty slot list with given dummy head
+static void slot_initialize(tw_timer *head)
+{
+    head->next = head;
+    head->prev = head;
+}
+
+// appends timer to the slot list with given dummy head
+static void slot_append(tw_timer *head, tw_timer *timer)
+{
+    timer->prev = head->prev;
+    timer->next = head;
+    head->prev->next = timer;
+    head->prev = timer;
+}
+
+// unlinks timer from its slot list
+static void slot_unlink(tw_timer *timer)
+{
+    timer->prev->next = timer->next;
+    timer->next->prev = timer->prev;
+}
+
+// moves all timers of the slot with dummy head src to the (empty) slot with dummy head dst
+static void slot_move(tw_timer *src, tw_timer *dst)
+{
+    if (src->next == src){
+        slot_initialize(dst);
+        return;
+    }
+    dst->next = src->next;
+    dst->prev = src->prev;
+    dst->next->prev = dst;
+    dst->prev->next = dst;
+    slot_initialize(src);
+}
+
+// places timer in the slot of the lowest wheel that covers its distance from the current time
+static void place_timer(tw_timer *timer, TimerWheel tw)
+{
+    unsigned long distance = timer->expires - tw->now;
+    // timers too far away are placed in the last slot of the last wheel that they can reach
+    if (distance > MAX_DISTANCE) distance = MAX_DISTANCE;
+    unsigned long slot_time = tw->now + distance;
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 && distance >> (WHEEL_BITS * (level + 1))) level++;
+    int slot = (slot_time >> (WHEEL_BITS * level)) & WHEEL_MASK;
+    slot_append(&tw->slots[level][slot], timer);
+}
+
+// re-schedules the timers of given slot of given wheel to the lower wheels
+static void cascade(TimerWheel tw, int level, int slot)
+{
+    tw_timer batch;
+    slot_move(&tw->slots[level][slot], &batch);
+    while (batch.next != &batch){
+        tw_timer *timer = batch.next;
+        slot_unlink(timer);
+        place_timer(timer, tw);
+    }
+}
+
+// Timer Wheel ADT functions
+
+// initializes an empty timer wheel
+void tw_initialize(TimerWheel *tw, ExpireFunc expire_func, DestroyFunc destroy_func, PrintFunc print_func)
+{
+    *tw = malloc(sizeof(struct timer_wheel));
+    assert(*tw);
+    for (int level = 0; level < WHEEL_LEVELS; level++){
+        for (int slot = 0; slot < WHEEL_SLOTS; slot++) slot_initialize(&(*tw)->slots[level][slot]);
+    }
+    (*tw)->now = 0;
+    (*tw)->size = 0;
+    tw_reset_stats(*tw);
+    tw_set_expire(*tw, expire_func);
+    tw_set_destroy(*tw, destroy_func);
+    tw_set_print(*tw, print_func);
+}
+
+// schedules a timer for given item, that expires after given number of ticks
+Timer tw_schedule(Pointer item, unsigned long ticks, TimerWheel tw)
+{
+    tw_timer *timer = malloc(sizeof(tw_timer));
+    assert(timer);
+    timer->data = item;
+    // a timer can't expire at the current tick, since its slot was already visited
+    timer->expires = tw->now + (ticks ? ticks : 1);
+    place_timer(timer, tw);
+    tw->size++;
+    STATS_INC(tw, allocations);
+    STATS_INC(tw, inserts);
+    STATS_MAX(tw, peak_size, tw->size);
+    return timer;
+}
+
+// cancels given timer and returns its item
+Pointer tw_cancel(Timer timer, TimerWheel tw)
+{
+    Pointer item = timer->data;
+    slot_unlink(timer);
+    free(timer);
+    tw->size--;
+    STATS_INC(tw, frees);
+    STATS_INC(tw, removes);
+    return item;
+}
+
+// advances the time by one tick and fires the expired timers
+size_t tw_tick(TimerWheel tw)
+{
+    tw->now++;
+    // every time a wheel completes a rotation, cascade the next slot of the wheel above
+    int level = 0;
+    while (level < WHEEL_LEVELS - 1 && !((tw->now >> (WHEEL_BITS * level)) & WHEEL_MASK)){
+        level++;
+        cascade(tw, level, (tw->now >> (WHEEL_BITS * level)) & WHEEL_MASK);
+    }
+    // detach the current slot of wheel 0; all of its timers expire now
+    // (ExpireFunc may schedule or cancel timers in the meantime)
+    tw_timer batch;
+    slot_move(&tw->slots[0][tw->now & WHEEL_MASK], &batch);
+    size_t expired = 0;
+    while (batch.next != &batch){
+        tw_timer *timer = batch.next;
+        slot_unlink(timer);
+        tw->size--;
+        expired++;
+        STATS_INC(tw, frees);
+        STATS_INC(tw, removes);
+        Pointer item = timer->data;
+        free(timer);
+        if (tw->Expire != NULL) tw->Expire(item);
+    }
+    return expired;
+}
+
+// advances the time by given number of ticks
+size_t tw_advance(unsigned long ticks, TimerWheel tw)
+{
+    size_t expired = 0;
+    for (unsigned long i = 0; i < ticks; i++) expired += tw_tick(tw);
+    return expired;
+}
+
+// returns the current time of the timer wheel
+unsigned long tw_now(TimerWheel tw)
+{
+    return tw->now;
+}
+
+// prints items of the pending timers based on given PrintFunc, wheel by wheel
+void tw_print(TimerWheel tw)
+{
+    // check if a PrintFunc exists and timer wheel isn't empty
+    if (tw->Print == NULL || tw_is_empty(tw)) return;
+    // else; print the items of all slots
+    for (int level = 0; level < WHEEL_LEVELS; level++){
+        for (int slot = 0; slot < WHEEL_SLOTS; slot++){
+            tw_timer *head = &tw->slots[level][slot];
+            for (tw_timer *timer = head->next; timer != head; timer = timer->next) tw->Print(timer->data);
+        }
+    }
+    printf("\n");
+}
+
+// destroys the given timer wheel
+void tw_destroy(TimerWheel tw)
+{
+    for (int level = 0; level < WHEEL_LEVELS; level++){
+        for (int slot = 0; slot < WHEEL_SLOTS; slot++){
+            tw_timer *head = &tw->slots[level][slot];
+            tw_timer *timer = head->next;
+            while (timer != head){
+                tw_timer *next = timer->next;
+                if (tw->Destroy != NULL) tw->Destroy(timer->data);
+                free(timer);
+                timer = next;
+            }
+        }
+    }
+    free(tw);
+}
+
+// returns the number of pending timers
+size_t tw_size(TimerWheel tw)
+{
+    return tw->size;
+}
+
+// returns true/false depending on if timer wheel has pending timers or not
+bool tw_is_empty(TimerWheel tw)
+{
+    if (!tw_size(tw)) return true;
+    else return false;
+}
+
+// returns the operation counters of the timer wheel
+AdtStats tw_get_stats(TimerWheel tw)
+{
+#ifdef ADT_STATS
+    return tw->stats;
+#else
+    AdtStats stats = {0};
+    return stats;
+#endif
+}
+
+// resets the operation counters of the timer wheel; the peak size becomes the current size
+void tw_reset_stats(TimerWheel tw)
+{
+#ifdef ADT_STATS
+    AdtStats stats = {0};
+    stats.peak_size = tw->size;
+    tw->stats = stats;
+#endif
+}
+
+// sets as new ExpireFunc of given timer wheel the given one
+void tw_set_expire(TimerWheel tw, ExpireFunc expire_func)
+{
+    tw->Expire = expire_func;
+}
+
+// sets as new DestroyFunc of given timer wheel the given one
+void tw_set_destroy(TimerWheel tw, DestroyFunc destroy_func)
+{
+    tw->Destroy = destroy_func;
+}
+
+// sets as new PrintFunc of given timer wheel the given one
+void tw_set_print(TimerWheel tw, PrintFunc print_func)
+{
+    tw->Print = print_func;
+}
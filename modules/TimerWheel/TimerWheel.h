@@ -0,0 +1,80 @@
+/* Interface file of Timer Wheel ADT */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "../Stats/Stats.h"
+
+// generic-pointer typedef
+typedef void *Pointer;
+
+// pointer to function called with the item of each expired timer
+typedef void (*ExpireFunc)(Pointer);
+
+// pointer to function that destroys given element
+typedef void (*DestroyFunc)(Pointer);
+
+// pointer to function printing timer wheel's item
+typedef void (*PrintFunc)(Pointer);
+
+// pointer to timer wheel
+typedef struct timer_wheel *TimerWheel;
+
+// pointer to a scheduled timer, used to cancel it
+// a timer handle is invalid after the timer expires or is canceled
+typedef struct tw_timer *Timer;
+
+/*-----Functions Provided-----*/
+
+// initializes an empty timer wheel at time (tick) 0
+void tw_initialize(TimerWheel *, ExpireFunc, DestroyFunc, PrintFunc);
+
+// schedules a timer for given item, expiring after given number of ticks (at least 1)
+// returns a handle that can be used to cancel the timer
+Timer tw_schedule(Pointer, unsigned long ticks, TimerWheel);
+
+// cancels given timer and returns its item, without destroying it
+Pointer tw_cancel(Timer, TimerWheel);
+
+// advances the time by one tick and calls the ExpireFunc for the items of all timers that expired
+// expired items are not destroyed by the timer wheel
+// returns the number of expired timers
+size_t tw_tick(TimerWheel);
+
+// advances the time by given number of ticks, firing expired timers as tw_tick does
+// returns the number of expired timers
+size_t tw_advance(unsigned long ticks, TimerWheel);
+
+// returns the current time (number of ticks since initialization)
+unsigned long tw_now(TimerWheel);
+
+// prints items of the pending timers
+void tw_print(TimerWheel);
+
+// destroys the given timer wheel by freeing all pending timers
+void tw_destroy(TimerWheel);
+
+// returns the number of pending timers
+size_t tw_size(TimerWheel);
+
+// returns true/false depending on if timer wheel has no pending timers or not
+bool tw_is_empty(TimerWheel);
+
+// returns the operation counters of the timer wheel (see Stats.h)
+AdtStats tw_get_stats(TimerWheel);
+
+// resets the operation counters of the timer wheel
+void tw_reset_stats(TimerWheel);
+
+// sets as new ExpireFunc of given timer wheel the given one
+void tw_set_expire(TimerWheel, ExpireFunc);
+
+// sets as new DestroyFunc of given timer wheel the given one
+void tw_set_destroy(TimerWheel, DestroyFunc);
+
+// sets as new PrintFunc of given timer wheel the given one
+void tw_set_print(TimerWheel, PrintFunc);
+
+#endif
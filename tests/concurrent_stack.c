@@ -0,0 +1,179 @@
+/* Tests of the Concurrent Stack: items pushed one by one and in batches by many threads, while they pop, are all
+   popped exactly once; the order of pops and batches, and the destruction of the items left in a stack */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "../lib/ADT.h"
+
+// threads pushing and popping, and items pushed by every thread
+#define THREADS 8
+#define ITEMS_PER_THREAD 50000
+
+// largest batch pushed with cs_push_many
+#define MAX_BATCH 16
+
+// item of the tests; it counts the times it was popped (or destroyed)
+typedef struct item{
+    int owner; // the thread that pushes the item
+    int index; // the position of the item in the pushes of its owner
+    atomic_int popped;
+}item;
+
+// number of failed checks
+static atomic_int failures;
+
+// checks a condition, reporting it if it's false
+#define CHECK(condition, name) do{ \
+    if (!(condition)){ \
+        printf("FAILED: %s (%s, line %d)\n", name, #condition, __LINE__); \
+        atomic_fetch_add(&failures, 1); \
+    } \
+}while (0)
+
+// DestroyFunc of the stacks
+void destroy_item(Pointer a)
+{
+    atomic_fetch_add(&((item *)a)->popped, 1);
+}
+
+// state shared by the threads of the concurrent test
+typedef struct shared{
+    ConcurrentStack cs;
+    item *items; // the items of all the threads; those of thread t start at t * ITEMS_PER_THREAD
+}shared;
+
+// arguments of a thread of the concurrent test
+typedef struct worker_args{
+    shared *sh;
+    int index;
+}worker_args;
+
+// pushes the thread's items, one by one or in batches, and pops about as many items as it pushes
+void *worker(void *arg)
+{
+    worker_args *wa = arg;
+    shared *sh = wa->sh;
+    item *items = &sh->items[wa->index * ITEMS_PER_THREAD];
+    unsigned seed = wa->index + 1;
+    // other threads keep pushing meanwhile, so the order of these pops isn't checked, only that each happens once
+    int pushed = 0;
+    Pointer batch[MAX_BATCH];
+    while (pushed < ITEMS_PER_THREAD){
+        int operation = rand_r(&seed) % 4;
+        if (operation == 0){
+            cs_push(&items[pushed++], sh->cs);
+        }
+        else if (operation == 1){
+            int n = rand_r(&seed) % (MAX_BATCH + 1);
+            if (n > ITEMS_PER_THREAD - pushed) n = ITEMS_PER_THREAD - pushed;
+            for (int i = 0; i < n; i++) batch[i] = &items[pushed++];
+            cs_push_many(batch, n, sh->cs);
+        }
+        else{
+            item *popped = cs_pop(sh->cs);
+            if (popped == NULL) continue;
+            CHECK(popped >= sh->items && popped < sh->items + THREADS * ITEMS_PER_THREAD, "popped item was pushed");
+            atomic_fetch_add(&popped->popped, 1);
+        }
+    }
+    return NULL;
+}
+
+// threads push disjoint ranges of items and pop at the same time; then the rest are popped, and each must be once
+void test_concurrent(void)
+{
+    shared sh;
+    cs_initialize(&sh.cs, NULL, NULL);
+    size_t n = THREADS * ITEMS_PER_THREAD;
+    sh.items = calloc(n, sizeof(item));
+    for (size_t i = 0; i < n; i++){
+        sh.items[i].owner = i / ITEMS_PER_THREAD;
+        sh.items[i].index = i % ITEMS_PER_THREAD;
+    }
+    pthread_t threads[THREADS];
+    worker_args args[THREADS];
+    for (int i = 0; i < THREADS; i++){
+        args[i] = (worker_args){ .sh = &sh, .index = i };
+        pthread_create(&threads[i], NULL, worker, &args[i]);
+    }
+    for (int i = 0; i < THREADS; i++) pthread_join(threads[i], NULL);
+    // the items left of every thread are popped in the reverse order of their pushes
+    size_t left = cs_size(sh.cs), popped = 0;
+    int last[THREADS];
+    for (int i = 0; i < THREADS; i++) last[i] = ITEMS_PER_THREAD;
+    bool lifo = true;
+    item *it;
+    while ((it = cs_pop(sh.cs)) != NULL){
+        if (it->index >= last[it->owner]) lifo = false;
+        last[it->owner] = it->index;
+        atomic_fetch_add(&it->popped, 1);
+        popped++;
+    }
+    CHECK(popped == left, "size after the concurrent pushes and pops");
+    CHECK(lifo, "items left popped in LIFO order");
+    CHECK(cs_is_empty(sh.cs) && cs_size(sh.cs) == 0, "stack empty after popping everything");
+    bool once = true;
+    for (size_t i = 0; i < n; i++){
+        if (atomic_load(&sh.items[i].popped) != 1) once = false;
+    }
+    CHECK(once, "every item popped exactly once");
+    cs_destroy(sh.cs);
+    free(sh.items);
+}
+
+// a batch ends up with its last item on top, above the items pushed before it
+void test_order(void)
+{
+    ConcurrentStack cs;
+    cs_initialize(&cs, NULL, NULL);
+    item items[2 * MAX_BATCH];
+    Pointer batch[MAX_BATCH];
+    for (int i = 0; i < MAX_BATCH; i++){
+        cs_push(&items[i], cs);
+        batch[i] = &items[MAX_BATCH + i];
+    }
+    cs_push_many(batch, MAX_BATCH, cs);
+    // an empty batch pushes nothing
+    cs_push_many(batch, 0, cs);
+    CHECK(cs_size(cs) == 2 * MAX_BATCH, "size after push and push_many");
+    bool lifo = true;
+    for (int i = 2 * MAX_BATCH - 1; i >= 0; i--){
+        if (cs_pop(cs) != &items[i]) lifo = false;
+    }
+    CHECK(lifo, "items popped in LIFO order");
+    CHECK(cs_pop(cs) == NULL && cs_is_empty(cs), "pop of an empty stack");
+    cs_destroy(cs);
+}
+
+// the items still in a stack are destroyed by cs_destroy, once, and the popped ones are not
+void test_destroy(void)
+{
+    ConcurrentStack cs;
+    cs_initialize(&cs, destroy_item, NULL);
+    item *items = calloc(ITEMS_PER_THREAD, sizeof(item));
+    for (int i = 0; i < ITEMS_PER_THREAD; i++) cs_push(&items[i], cs);
+    for (int i = 0; i < ITEMS_PER_THREAD / 2; i++) cs_pop(cs);
+    cs_destroy(cs);
+    bool destroyed = true;
+    for (int i = 0; i < ITEMS_PER_THREAD; i++){
+        if (atomic_load(&items[i].popped) != (i < ITEMS_PER_THREAD / 2)) destroyed = false;
+    }
+    CHECK(destroyed, "items left destroyed once by cs_destroy");
+    free(items);
+}
+
+int main(void)
+{
+    test_concurrent();
+    test_order();
+    test_destroy();
+    if (atomic_load(&failures)){
+        printf("concurrent_stack: %d checks failed\n", atomic_load(&failures));
+        return 1;
+    }
+    printf("concurrent_stack: OK\n");
+    return 0;
+}
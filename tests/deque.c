@@ -0,0 +1,234 @@
+/* Tests of the concatenation and split of Deques, and of the concatenation of Queues, against reference arrays,
+   including empty sources and destinations and splits at the front and past the back */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../lib/ADT.h"
+
+// the items are the integers of [0, RANGE); the containers point to them, and a destroyed item is counted
+#define RANGE 300
+
+// number of random rounds of every test
+#define ROUNDS 500
+
+// the items
+static int values[RANGE];
+
+// number of times every item was destroyed
+static int destroyed[RANGE];
+
+// item inserted and removed before the items of a queue; it's never destroyed, since removing doesn't destroy
+static int filler = -1;
+
+// number of failed checks
+static int failures;
+
+// checks a condition, reporting it if it's false
+#define CHECK(condition, name) do{ \
+    if (!(condition)){ \
+        printf("FAILED: %s (%s, line %d)\n", name, #condition, __LINE__); \
+        failures++; \
+    } \
+}while (0)
+
+// DestroyFunc of the containers
+void destroy_value(Pointer a)
+{
+    destroyed[*(int *)a]++;
+}
+
+// a reference sequence of items
+typedef struct sequence{
+    int items[RANGE];
+    size_t size;
+}sequence;
+
+// fills deque and reference sequence with n items, taken from *next onwards
+void fill_deque(Deque *dq, sequence *s, size_t n, int *next)
+{
+    deque_initialize(dq, destroy_value, NULL);
+    s->size = 0;
+    for (size_t i = 0; i < n; i++){
+        deque_insert_back(&values[*next], *dq);
+        s->items[s->size++] = (*next)++;
+    }
+}
+
+// fills queue and reference sequence with n items, taken from *next onwards
+// some items are inserted and removed first, so that the front block doesn't start at its first item
+void fill_queue(Queue *q, sequence *s, size_t n, int *next)
+{
+    queue_initialize(q, destroy_value, NULL);
+    s->size = 0;
+    int removed = rand() % 40;
+    for (int i = 0; i < removed; i++) queue_insert(&filler, *q);
+    for (int i = 0; i < removed; i++) queue_remove(*q);
+    for (size_t i = 0; i < n; i++){
+        queue_insert(&values[*next], *q);
+        s->items[s->size++] = (*next)++;
+    }
+}
+
+// returns true if the deque has exactly the items of the sequence, in order
+bool deque_matches(Deque dq, sequence *s)
+{
+    if (deque_size(dq) != s->size || deque_is_empty(dq) != (s->size == 0)) return false;
+    if (s->size == 0) return deque_front(dq) == NULL && deque_rear(dq) == NULL;
+    if (deque_front(dq) != &values[s->items[0]] || deque_rear(dq) != &values[s->items[s->size - 1]]) return false;
+    DequeIterator it;
+    deque_iterator_init(&it, dq);
+    for (size_t i = 0; i < s->size; i++){
+        if (deque_iterator_next(&it) != &values[s->items[i]]) return false;
+    }
+    return deque_iterator_next(&it) == NULL;
+}
+
+// returns true if the queue has exactly the items of the sequence, in order
+bool queue_matches(Queue q, sequence *s)
+{
+    if (queue_size(q) != s->size || queue_is_empty(q) != (s->size == 0)) return false;
+    if (s->size == 0) return queue_front(q) == NULL && queue_rear(q) == NULL;
+    if (queue_front(q) != &values[s->items[0]] || queue_rear(q) != &values[s->items[s->size - 1]]) return false;
+    QueueIterator it;
+    queue_iterator_init(&it, q);
+    for (size_t i = 0; i < s->size; i++){
+        if (queue_iterator_next(&it) != &values[s->items[i]]) return false;
+    }
+    return queue_iterator_next(&it) == NULL;
+}
+
+// appends the items of sequence src to sequence dst, leaving src empty
+void sequence_concat(sequence *dst, sequence *src)
+{
+    for (size_t i = 0; i < src->size; i++) dst->items[dst->size++] = src->items[i];
+    src->size = 0;
+}
+
+// returns a random size for a container of a round, often 0 or 1
+size_t random_size(size_t max)
+{
+    int kind = rand() % 4;
+    return kind == 0 ? 0 : kind == 1 ? 1 : rand() % (max + 1);
+}
+
+// returns true if every item in [0, n) was destroyed exactly once, and resets the counts
+bool destroyed_once(int n)
+{
+    bool once = true;
+    for (int i = 0; i < n; i++){
+        if (destroyed[i] != 1) once = false;
+        destroyed[i] = 0;
+    }
+    return once;
+}
+
+// concatenates deques of random sizes, including empty ones, then keeps using both
+void test_deque_concat(void)
+{
+    for (int round = 0; round < ROUNDS; round++){
+        Deque dst, src;
+        sequence dst_s, src_s;
+        int next = 0;
+        fill_deque(&dst, &dst_s, random_size(RANGE / 3), &next);
+        fill_deque(&src, &src_s, random_size(RANGE / 3), &next);
+        deque_concat(dst, src);
+        // concatenating a deque to itself does nothing
+        deque_concat(dst, dst);
+        sequence_concat(&dst_s, &src_s);
+        CHECK(deque_matches(dst, &dst_s), "dst after deque_concat");
+        CHECK(deque_matches(src, &src_s), "src empty after deque_concat");
+        // both ends of both deques are still right
+        deque_insert_back(&values[next], src);
+        src_s.items[src_s.size++] = next++;
+        deque_insert_back(&values[next], dst);
+        dst_s.items[dst_s.size++] = next++;
+        deque_remove_back(dst);
+        dst_s.size--;
+        CHECK(deque_matches(dst, &dst_s) && deque_matches(src, &src_s), "deques usable after deque_concat");
+        deque_destroy(dst);
+        deque_destroy(src);
+        // the item removed from dst isn't destroyed
+        destroyed[next - 1]++;
+        CHECK(destroyed_once(next), "every item destroyed once after deque_concat");
+    }
+}
+
+// splits deques of random sizes at random indices, including 0 and past the back, then concatenates the parts back
+void test_deque_split(void)
+{
+    for (int round = 0; round < ROUNDS; round++){
+        Deque dq, back;
+        sequence s, back_s;
+        int next = 0;
+        fill_deque(&dq, &s, random_size(RANGE / 2), &next);
+        int kind = rand() % 4;
+        size_t index = kind == 0 ? 0 : kind == 1 ? s.size + rand() % 3 : rand() % (s.size + 1);
+        deque_split_at(index, dq, &back);
+        back_s.size = 0;
+        for (size_t i = index; i < s.size; i++) back_s.items[back_s.size++] = s.items[i];
+        if (index < s.size) s.size = index;
+        CHECK(deque_matches(dq, &s), "front part after deque_split_at");
+        CHECK(deque_matches(back, &back_s), "back part after deque_split_at");
+        // both parts are usable deques: insert at both ends of the front part, and join the parts back
+        deque_insert_front(&values[next], dq);
+        for (size_t i = s.size; i > 0; i--) s.items[i] = s.items[i - 1];
+        s.items[0] = next++;
+        s.size++;
+        deque_insert_back(&values[next], dq);
+        s.items[s.size++] = next++;
+        CHECK(deque_matches(dq, &s), "front part usable after deque_split_at");
+        deque_concat(dq, back);
+        sequence_concat(&s, &back_s);
+        CHECK(deque_matches(dq, &s), "parts joined after deque_split_at");
+        deque_destroy(dq);
+        deque_destroy(back);
+        CHECK(destroyed_once(next), "every item destroyed once after deque_split_at");
+    }
+}
+
+// concatenates queues of random sizes, including empty ones and ones emptied by removes, then keeps using both
+void test_queue_concat(void)
+{
+    for (int round = 0; round < ROUNDS; round++){
+        Queue dst, src;
+        sequence dst_s, src_s;
+        int next = 0;
+        fill_queue(&dst, &dst_s, random_size(RANGE / 3), &next);
+        fill_queue(&src, &src_s, random_size(RANGE / 3), &next);
+        queue_concat(dst, src);
+        queue_concat(dst, dst);
+        sequence_concat(&dst_s, &src_s);
+        CHECK(queue_matches(dst, &dst_s), "dst after queue_concat");
+        CHECK(queue_matches(src, &src_s), "src empty after queue_concat");
+        // both queues are still usable: insert in both, and remove the front of dst
+        queue_insert(&values[next], src);
+        src_s.items[src_s.size++] = next++;
+        queue_insert(&values[next], dst);
+        dst_s.items[dst_s.size++] = next++;
+        int *front = queue_remove(dst);
+        CHECK(front == &values[dst_s.items[0]], "front of dst after queue_concat");
+        destroyed[*front]++;
+        for (size_t i = 1; i < dst_s.size; i++) dst_s.items[i - 1] = dst_s.items[i];
+        dst_s.size--;
+        CHECK(queue_matches(dst, &dst_s) && queue_matches(src, &src_s), "queues usable after queue_concat");
+        queue_destroy(dst);
+        queue_destroy(src);
+        CHECK(destroyed_once(next), "every item destroyed once after queue_concat");
+    }
+}
+
+int main(void)
+{
+    srand(1);
+    for (int i = 0; i < RANGE; i++) values[i] = i;
+    test_deque_concat();
+    test_deque_split();
+    test_queue_concat();
+    if (failures){
+        printf("deque: %d checks failed\n", failures);
+        return 1;
+    }
+    printf("deque: OK\n");
+    return 0;
+}
@@ -0,0 +1,184 @@
+/* Tests of the Epoch memory reclamation: every retired item is destroyed exactly once, never while a critical
+   section that might have seen it is running, and the pending items drain once the critical sections are over */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../lib/ADT.h"
+
+// threads retiring items and threads reading them, and items retired by every retiring thread
+#define WRITERS 4
+#define READERS 2
+#define ITEMS_PER_WRITER 20000
+
+// number of items of the single-threaded tests
+#define ITEMS 1000
+
+// collects tried before the pending items must have drained
+#define MAX_COLLECTS 10000
+
+// item of the tests; destroying it only marks it, so that a read after the destruction is detected instead of crashing
+typedef struct item{
+    atomic_int destroyed; // number of times the item was destroyed
+}item;
+
+// number of failed checks
+static atomic_int failures;
+
+// checks a condition, reporting it if it's false
+#define CHECK(condition, name) do{ \
+    if (!(condition)){ \
+        printf("FAILED: %s (%s, line %d)\n", name, #condition, __LINE__); \
+        atomic_fetch_add(&failures, 1); \
+    } \
+}while (0)
+
+// DestroyFunc of the items
+void destroy_item(Pointer a)
+{
+    atomic_fetch_add(&((item *)a)->destroyed, 1);
+}
+
+// returns the number of given items that were destroyed, checking that none was destroyed twice
+size_t count_destroyed(item *items, size_t n)
+{
+    size_t destroyed = 0;
+    for (size_t i = 0; i < n; i++){
+        int times = atomic_load(&items[i].destroyed);
+        CHECK(times <= 1, "item destroyed at most once");
+        if (times) destroyed++;
+    }
+    return destroyed;
+}
+
+// calls ep_collect until the items of the domain retired by the calling thread are destroyed
+// returns false if they aren't, after MAX_COLLECTS tries
+bool drain(EpochDomain ed)
+{
+    for (int i = 0; i < MAX_COLLECTS && ep_pending(ed); i++){
+        ep_collect(ed);
+        sched_yield();
+    }
+    return ep_pending(ed) == 0;
+}
+
+// nothing retired during a critical section is destroyed before it ends, and everything is destroyed after it
+void test_critical_section(void)
+{
+    EpochDomain ed;
+    ep_initialize(&ed);
+    item *items = calloc(ITEMS, sizeof(item));
+    ep_enter(ed);
+    // nested sections end with the outermost one
+    ep_enter(ed);
+    for (int i = 0; i < ITEMS; i++) ep_retire(&items[i], destroy_item, ed);
+    ep_exit(ed);
+    for (int i = 0; i < 10; i++) ep_collect(ed);
+    CHECK(count_destroyed(items, ITEMS) == 0, "no item destroyed inside the critical section");
+    CHECK(ep_pending(ed) == ITEMS, "pending items inside the critical section");
+    ep_exit(ed);
+    CHECK(drain(ed), "pending items drain after the critical section");
+    CHECK(count_destroyed(items, ITEMS) == ITEMS, "every item destroyed after the critical section");
+    ep_destroy(ed);
+    CHECK(count_destroyed(items, ITEMS) == ITEMS, "no item destroyed again by ep_destroy");
+    free(items);
+}
+
+// the items still pending are destroyed by ep_destroy, once
+void test_destroy(void)
+{
+    EpochDomain ed;
+    ep_initialize(&ed);
+    item *items = calloc(ITEMS, sizeof(item));
+    ep_enter(ed);
+    for (int i = 0; i < ITEMS; i++) ep_retire(&items[i], destroy_item, ed);
+    ep_exit(ed);
+    ep_destroy(ed);
+    CHECK(count_destroyed(items, ITEMS) == ITEMS, "every pending item destroyed by ep_destroy");
+    free(items);
+}
+
+// state shared by the threads of the concurrent test
+typedef struct shared{
+    EpochDomain ed;
+    _Atomic(item *) current; // the item the readers read; replaced and retired by the writers
+    item *items; // the items of all the writers
+    atomic_int writing; // number of writers still replacing items
+    pthread_barrier_t retired; // passed by the writers once they have retired all their items
+}shared;
+
+// reads the current item in critical sections, checking that it isn't destroyed, until the writers are done
+void *reader(void *arg)
+{
+    shared *sh = arg;
+    while (atomic_load(&sh->writing)){
+        ep_enter(sh->ed);
+        item *current = atomic_load(&sh->current);
+        CHECK(atomic_load(&current->destroyed) == 0, "item read after its destruction");
+        ep_exit(sh->ed);
+    }
+    return NULL;
+}
+
+// replaces the current item with each of the writer's items and retires the replaced one, then drains
+void *writer(void *arg)
+{
+    shared *sh = ((void **)arg)[0];
+    item *items = ((void **)arg)[1];
+    for (int i = 0; i < ITEMS_PER_WRITER; i++){
+        ep_enter(sh->ed);
+        item *previous = atomic_exchange(&sh->current, &items[i]);
+        ep_exit(sh->ed);
+        ep_retire(previous, destroy_item, sh->ed);
+    }
+    atomic_fetch_sub(&sh->writing, 1);
+    // the last item is still current; every other one must be destroyed once all the writers collect
+    pthread_barrier_wait(&sh->retired);
+    CHECK(drain(sh->ed), "pending items drain after the writers are done");
+    return NULL;
+}
+
+// writers replace and retire items while readers read them
+void test_concurrent(void)
+{
+    shared sh;
+    ep_initialize(&sh.ed);
+    size_t n = WRITERS * ITEMS_PER_WRITER + 1;
+    sh.items = calloc(n, sizeof(item));
+    atomic_init(&sh.current, &sh.items[n - 1]);
+    atomic_init(&sh.writing, WRITERS);
+    pthread_barrier_init(&sh.retired, NULL, WRITERS);
+    pthread_t threads[WRITERS + READERS];
+    void *args[WRITERS][2];
+    for (int i = 0; i < READERS; i++) pthread_create(&threads[WRITERS + i], NULL, reader, &sh);
+    for (int i = 0; i < WRITERS; i++){
+        args[i][0] = &sh;
+        args[i][1] = &sh.items[i * ITEMS_PER_WRITER];
+        pthread_create(&threads[i], NULL, writer, args[i]);
+    }
+    for (int i = 0; i < WRITERS + READERS; i++) pthread_join(threads[i], NULL);
+    CHECK(ep_pending(sh.ed) == 0, "no pending items after the threads exit");
+    // all the items but the current one are retired, and so destroyed
+    CHECK(count_destroyed(sh.items, n) == n - 1, "every retired item destroyed");
+    CHECK(atomic_load(&atomic_load(&sh.current)->destroyed) == 0, "current item not destroyed");
+    ep_destroy(sh.ed);
+    CHECK(count_destroyed(sh.items, n) == n - 1, "no item destroyed again by ep_destroy");
+    pthread_barrier_destroy(&sh.retired);
+    free(sh.items);
+}
+
+int main(void)
+{
+    test_critical_section();
+    test_destroy();
+    test_concurrent();
+    if (atomic_load(&failures)){
+        printf("epoch: %d checks failed\n", atomic_load(&failures));
+        return 1;
+    }
+    printf("epoch: OK\n");
+    return 0;
+}
@@ -0,0 +1,206 @@
+/* Tests of the join, split, set and batch operations of the Red-Black Tree against a reference set */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "../lib/ADT.h"
+
+// the items are the integers of [0, RANGE), and a reference set is an array of RANGE flags
+#define RANGE 2000
+
+// number of random rounds of every test
+#define ROUNDS 200
+
+// the items; the trees point to them, so they are never destroyed
+static int values[RANGE];
+
+// number of failed checks
+static int failures;
+
+// CompareFunc of the trees
+int compare_ints(Pointer a, Pointer b)
+{
+    return *(int *)a - *(int *)b;
+}
+
+// checks a condition, reporting it if it's false
+#define CHECK(condition, name) do{ \
+    if (!(condition)){ \
+        printf("FAILED: %s (%s, line %d)\n", name, #condition, __LINE__); \
+        failures++; \
+    } \
+}while (0)
+
+// fills tree and reference set with about density * RANGE random items from [low, high)
+void random_set(RedBlackTree *rbt, bool *set, int low, int high, double density)
+{
+    red_black_initialize(rbt, compare_ints, NULL, NULL);
+    for (int i = 0; i < RANGE; i++) set[i] = false;
+    for (int i = low; i < high; i++){
+        if (rand() < density * RAND_MAX){
+            red_black_insert(&values[i], *rbt);
+            set[i] = true;
+        }
+    }
+}
+
+// returns true if the tree has exactly the items of the reference set, in order, and is a valid red black tree
+bool matches(RedBlackTree rbt, bool *set)
+{
+    if (!red_black_verify(rbt)) return false;
+    RBTIterator it;
+    red_black_iterator_init(&it, rbt);
+    size_t count = 0;
+    for (int i = 0; i < RANGE; i++){
+        if (!set[i]) continue;
+        int *item = red_black_iterator_next(&it);
+        if (item == NULL || *item != i) return false;
+        count++;
+    }
+    return red_black_iterator_next(&it) == NULL && red_black_size(rbt) == count;
+}
+
+// joins trees of random items below and above a random key
+void test_join(void)
+{
+    bool a_set[RANGE], b_set[RANGE];
+    for (int round = 0; round < ROUNDS; round++){
+        int key = rand() % RANGE;
+        RedBlackTree a, b;
+        random_set(&a, a_set, 0, key, (double)rand() / RAND_MAX);
+        random_set(&b, b_set, key, RANGE, (double)rand() / RAND_MAX);
+        // overlapping trees are rejected, and left unchanged
+        if (!red_black_is_empty(a) && !red_black_is_empty(b)){
+            CHECK(!red_black_join(b, a), "join of overlapping trees");
+            CHECK(matches(a, a_set) && matches(b, b_set), "trees after a rejected join");
+        }
+        CHECK(red_black_join(a, b), "join");
+        for (int i = 0; i < RANGE; i++) a_set[i] = a_set[i] || b_set[i];
+        CHECK(matches(a, a_set), "items after join");
+        red_black_destroy(a);
+    }
+}
+
+// splits trees of random items around a random key, which may or may not be in the tree
+void test_split(void)
+{
+    bool set[RANGE], greater_set[RANGE];
+    for (int round = 0; round < ROUNDS; round++){
+        RedBlackTree rbt, greater;
+        random_set(&rbt, set, 0, RANGE, (double)rand() / RAND_MAX);
+        // the key is also out of the range of the items sometimes, so that one part is empty
+        int key = rand() % (RANGE + 2) - 1;
+        int outside = key;
+        bool present = key >= 0 && key < RANGE && set[key];
+        int *found = red_black_split(&outside, rbt, &greater);
+        CHECK(present ? found != NULL && *found == key : found == NULL, "item found by split");
+        for (int i = 0; i < RANGE; i++){
+            greater_set[i] = set[i] && i > key;
+            set[i] = set[i] && i < key;
+        }
+        // on odd rounds the parts are joined back before their sizes are counted
+        if (round % 2 == 0){
+            CHECK(matches(rbt, set), "smaller part after split");
+            CHECK(matches(greater, greater_set), "greater part after split");
+        }
+        // the parts are usable trees: join them back and keep inserting
+        CHECK(red_black_join(rbt, greater), "join after split");
+        for (int i = 0; i < RANGE; i++) set[i] = set[i] || greater_set[i];
+        int item = rand() % RANGE;
+        if (!set[item]){
+            red_black_insert(&values[item], rbt);
+            set[item] = true;
+        }
+        CHECK(matches(rbt, set), "items after split, join and insert");
+        red_black_destroy(rbt);
+    }
+}
+
+// runs union, intersection and difference of trees of random items, of random (and different) densities
+void test_set_operations(bool parallel, ThreadPool tp)
+{
+    bool a_set[RANGE], b_set[RANGE], expected[RANGE];
+    for (int round = 0; round < ROUNDS; round++){
+        for (int operation = 0; operation < 3; operation++){
+            RedBlackTree a, b;
+            // overlapping key ranges, so that every operation has items on one side only and on both sides
+            int low = rand() % RANGE, high = low + rand() % (RANGE - low + 1);
+            random_set(&a, a_set, 0, high, (double)rand() / RAND_MAX);
+            random_set(&b, b_set, low, RANGE, (double)rand() / RAND_MAX);
+            if (operation == 0){
+                if (parallel) red_black_union_parallel(a, b, tp);
+                else red_black_union(a, b);
+                for (int i = 0; i < RANGE; i++) expected[i] = a_set[i] || b_set[i];
+                CHECK(matches(a, expected), parallel ? "items after parallel union" : "items after union");
+            }
+            else if (operation == 1){
+                red_black_intersect(a, b);
+                for (int i = 0; i < RANGE; i++) expected[i] = a_set[i] && b_set[i];
+                CHECK(matches(a, expected), "items after intersection");
+            }
+            else{
+                red_black_difference(a, b);
+                for (int i = 0; i < RANGE; i++) expected[i] = a_set[i] && !b_set[i];
+                CHECK(matches(a, expected), "items after difference");
+            }
+            red_black_destroy(a);
+        }
+    }
+}
+
+// inserts large batches of random items, with many equal ones, in parallel; for every key, the first item of the batch
+// with it must be in the tree, so the parallel sort and its merges must be stable
+void test_insert_many_parallel(ThreadPool tp)
+{
+    size_t n = 100000;
+    int *keys = malloc(n * sizeof(int));
+    Pointer *items = malloc(n * sizeof(Pointer));
+    int *first = malloc(RANGE * sizeof(int));
+    for (int round = 0; round < 5; round++){
+        RedBlackTree rbt;
+        bool set[RANGE];
+        // some items are already in the tree, and are kept
+        random_set(&rbt, set, 0, RANGE, 0.1);
+        for (int i = 0; i < RANGE; i++) first[i] = -1;
+        for (size_t i = 0; i < n; i++){
+            keys[i] = rand() % RANGE;
+            items[i] = &keys[i];
+            if (first[keys[i]] < 0) first[keys[i]] = i;
+        }
+        red_black_insert_many_parallel(items, n, rbt, tp);
+        bool stable = true;
+        for (int i = 0; i < RANGE; i++){
+            if (first[i] >= 0 || set[i]){
+                int *item = red_black_find(&values[i], rbt);
+                if (item != (set[i] ? &values[i] : &keys[first[i]])) stable = false;
+                set[i] = true;
+            }
+        }
+        CHECK(stable, "first item of every key kept by insert_many_parallel");
+        CHECK(matches(rbt, set), "items after insert_many_parallel");
+        red_black_destroy(rbt);
+    }
+    free(keys);
+    free(items);
+    free(first);
+}
+
+int main(void)
+{
+    srand(1);
+    for (int i = 0; i < RANGE; i++) values[i] = i;
+    test_join();
+    test_split();
+    test_set_operations(false, NULL);
+    ThreadPool tp;
+    tp_initialize(&tp, 4);
+    test_set_operations(true, tp);
+    test_insert_many_parallel(tp);
+    tp_destroy(tp);
+    if (failures){
+        printf("red_black_tree: %d checks failed\n", failures);
+        return 1;
+    }
+    printf("red_black_tree: OK\n");
+    return 0;
+}
@@ -0,0 +1,252 @@
+/* Tests of the Skip List: concurrent inserts, removes and searches against a reference set, the order and limits of
+   sl_range, and the destruction of every inserted item exactly once */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "../lib/ADT.h"
+
+// the keys are the integers of [0, RANGE); every thread owns the keys equal to its index modulo THREADS
+#define RANGE 4000
+#define THREADS 4
+
+// operations of every thread in the concurrent test, and of the single-threaded tests
+#define OPERATIONS 50000
+
+// item of the tests; every insert uses a new item, so that each one can be checked to be destroyed exactly once
+typedef struct item{
+    int key;
+    atomic_int destroyed; // number of times the item was destroyed
+}item;
+
+// number of failed checks
+static atomic_int failures;
+
+// checks a condition, reporting it if it's false
+#define CHECK(condition, name) do{ \
+    if (!(condition)){ \
+        printf("FAILED: %s (%s, line %d)\n", name, #condition, __LINE__); \
+        atomic_fetch_add(&failures, 1); \
+    } \
+}while (0)
+
+// CompareFunc of the lists
+int compare_items(Pointer a, Pointer b)
+{
+    return ((item *)a)->key - ((item *)b)->key;
+}
+
+// DestroyFunc of the lists
+void destroy_item(Pointer a)
+{
+    atomic_fetch_add(&((item *)a)->destroyed, 1);
+}
+
+// context of check_order: the key of the previously visited item, and the limits of the range
+typedef struct order{
+    int previous, low, high;
+    bool sorted;
+}order;
+
+// VisitFunc that checks the visited items are ascending, not destroyed, and within the range
+bool check_order(Pointer a, void *context)
+{
+    order *o = context;
+    item *it = a;
+    if (it->key <= o->previous || it->key < o->low || it->key > o->high || atomic_load(&it->destroyed)) o->sorted = false;
+    o->previous = it->key;
+    return true;
+}
+
+// VisitFunc that stops once it has visited *context items
+bool visit_some(Pointer a, void *context)
+{
+    (void)a;
+    return --*(int *)context > 0;
+}
+
+// returns the number of given items that were destroyed, checking that none was destroyed twice
+size_t count_destroyed(item *items, size_t n)
+{
+    size_t destroyed = 0;
+    for (size_t i = 0; i < n; i++){
+        int times = atomic_load(&items[i].destroyed);
+        CHECK(times <= 1, "item destroyed at most once");
+        if (times) destroyed++;
+    }
+    return destroyed;
+}
+
+// state shared by the threads of the concurrent test
+typedef struct shared{
+    SkipList sl;
+    bool present[RANGE]; // the reference set; every thread writes the flags of its own keys only
+    atomic_int inserted; // number of successful inserts
+}shared;
+
+// arguments of a thread of the concurrent test
+typedef struct worker_args{
+    shared *sh;
+    int index;
+    item *items; // OPERATIONS items for the inserts of the thread
+}worker_args;
+
+// inserts and removes the thread's own keys, checking them against the reference set, and searches all the keys
+void *worker(void *arg)
+{
+    worker_args *wa = arg;
+    shared *sh = wa->sh;
+    unsigned seed = wa->index + 1;
+    int used = 0;
+    for (int i = 0; i < OPERATIONS; i++){
+        int key = rand_r(&seed) % RANGE, operation = rand_r(&seed) % 8;
+        int own = key - key % THREADS + wa->index;
+        if (own >= RANGE) own -= THREADS;
+        item probe = { .key = key };
+        if (operation < 3){
+            item *new = &wa->items[used++];
+            new->key = own;
+            bool inserted = sl_insert(new, sh->sl);
+            CHECK(inserted != sh->present[own], "insert succeeds only for absent keys");
+            if (inserted){
+                sh->present[own] = true;
+                atomic_fetch_add(&sh->inserted, 1);
+            }
+        }
+        else if (operation < 5){
+            probe.key = own;
+            CHECK(sl_remove(&probe, sh->sl) == sh->present[own], "remove succeeds only for present keys");
+            sh->present[own] = false;
+        }
+        else if (operation < 7){
+            // only the thread's own keys are known, but any found item must be equal and alive while in the section
+            ep_enter(sl_epoch(sh->sl));
+            item *found = sl_find(&probe, sh->sl);
+            CHECK(found == NULL || (found->key == key && atomic_load(&found->destroyed) == 0), "item found");
+            ep_exit(sl_epoch(sh->sl));
+            probe.key = own;
+            CHECK(sl_search(&probe, sh->sl) == sh->present[own], "search of own key");
+        }
+        else{
+            item high = { .key = key + 100 };
+            order o = { .previous = -1, .low = key, .high = high.key, .sorted = true };
+            ep_enter(sl_epoch(sh->sl));
+            sl_range(&probe, &high, check_order, &o, sh->sl);
+            ep_exit(sl_epoch(sh->sl));
+            CHECK(o.sorted, "concurrent range in order and within its limits");
+        }
+    }
+    return NULL;
+}
+
+// threads insert, remove and search at the same time; then the list must match the reference set
+void test_concurrent(void)
+{
+    shared *sh = calloc(1, sizeof(shared));
+    CHECK(sl_initialize(&sh->sl, compare_items, destroy_item, NULL), "initialize");
+    atomic_init(&sh->inserted, 0);
+    size_t n = THREADS * OPERATIONS;
+    item *items = calloc(n, sizeof(item));
+    pthread_t threads[THREADS];
+    worker_args args[THREADS];
+    for (int i = 0; i < THREADS; i++){
+        args[i] = (worker_args){ .sh = sh, .index = i, .items = &items[i * OPERATIONS] };
+        pthread_create(&threads[i], NULL, worker, &args[i]);
+    }
+    for (int i = 0; i < THREADS; i++) pthread_join(threads[i], NULL);
+    size_t count = 0;
+    bool matches = true;
+    for (int i = 0; i < RANGE; i++){
+        item probe = { .key = i };
+        if (sl_search(&probe, sh->sl) != sh->present[i]) matches = false;
+        count += sh->present[i];
+    }
+    CHECK(matches, "items after the concurrent operations");
+    CHECK(sl_size(sh->sl) == count, "size after the concurrent operations");
+    order o = { .previous = -1, .low = 0, .high = RANGE, .sorted = true };
+    CHECK(sl_range(NULL, NULL, check_order, &o, sh->sl) == count && o.sorted, "whole list in order");
+    sl_destroy(sh->sl);
+    // every inserted item, removed or not, is destroyed by now; the rejected ones never are
+    CHECK(count_destroyed(items, n) == (size_t)atomic_load(&sh->inserted), "every inserted item destroyed once");
+    free(items);
+    free(sh);
+}
+
+// visits ranges with and without limits, and stops early, on a list of the even keys
+void test_range(void)
+{
+    SkipList sl;
+    CHECK(sl_initialize(&sl, compare_items, NULL, NULL), "initialize");
+    item *items = calloc(RANGE / 2, sizeof(item));
+    // inserted in a shuffled order
+    for (int i = 0; i < RANGE / 2; i++) items[i].key = 2 * i;
+    for (int i = RANGE / 2 - 1; i > 0; i--){
+        int j = rand() % (i + 1), key = items[i].key;
+        items[i].key = items[j].key;
+        items[j].key = key;
+    }
+    for (int i = 0; i < RANGE / 2; i++) sl_insert(&items[i], sl);
+    for (int round = 0; round < OPERATIONS / 100; round++){
+        item low = { .key = rand() % (RANGE + 2) - 1 }, high = { .key = low.key + rand() % 200 - 20 };
+        order o = { .previous = -1, .low = low.key, .high = high.key, .sorted = true };
+        size_t visited = sl_range(&low, &high, check_order, &o, sl);
+        // the even keys of [max(low, 0), min(high, RANGE - 1)]
+        int first = low.key < 0 ? 0 : (low.key + 1) / 2, last = high.key >= RANGE ? RANGE / 2 - 1 : high.key / 2;
+        if (high.key < 0) last = -1;
+        CHECK(o.sorted, "range in order and within its limits");
+        CHECK(visited == (size_t)(last >= first ? last - first + 1 : 0), "number of items in range");
+    }
+    order o = { .previous = -1, .low = RANGE - 100, .high = RANGE, .sorted = true };
+    item low = { .key = RANGE - 100 };
+    CHECK(sl_range(&low, NULL, check_order, &o, sl) == 50 && o.sorted, "range without upper limit");
+    o = (order){ .previous = -1, .low = 0, .high = 99, .sorted = true };
+    item high = { .key = 99 };
+    CHECK(sl_range(NULL, &high, check_order, &o, sl) == 50 && o.sorted, "range without lower limit");
+    int remaining = 10;
+    CHECK(sl_range(NULL, NULL, visit_some, &remaining, sl) == 10, "range stopped by its VisitFunc");
+    sl_destroy(sl);
+    free(items);
+}
+
+// lists sharing a domain: the items removed from a destroyed list are destroyed by the domain, once
+void test_shared_domain(void)
+{
+    EpochDomain ed;
+    CHECK(ep_initialize(&ed), "initialize domain");
+    SkipList a, b;
+    sl_initialize_shared(&a, ed, compare_items, destroy_item, NULL);
+    sl_initialize_shared(&b, ed, compare_items, destroy_item, NULL);
+    CHECK(sl_epoch(a) == ed && sl_epoch(b) == ed, "lists use the given domain");
+    size_t n = 2 * RANGE;
+    item *items = calloc(n, sizeof(item));
+    for (size_t i = 0; i < n; i++){
+        items[i].key = i / 2;
+        sl_insert(&items[i], i % 2 ? b : a);
+    }
+    // remove half of the items of a inside a critical section, so that they are still pending when a is destroyed
+    ep_enter(ed);
+    for (int i = 0; i < RANGE; i += 2) sl_remove(&items[2 * i], a);
+    ep_exit(ed);
+    sl_destroy(a);
+    CHECK(count_destroyed(items, n) <= RANGE, "only the items of the destroyed list destroyed");
+    sl_destroy(b);
+    ep_destroy(ed);
+    CHECK(count_destroyed(items, n) == n, "every item destroyed once");
+    free(items);
+}
+
+int main(void)
+{
+    srand(1);
+    test_concurrent();
+    test_range();
+    test_shared_domain();
+    if (atomic_load(&failures)){
+        printf("skip_list: %d checks failed\n", atomic_load(&failures));
+        return 1;
+    }
+    printf("skip_list: OK\n");
+    return 0;
+}